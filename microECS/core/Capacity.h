@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Shared.h"
+#include "SoA.h"
+#include "Types.h"
+
+#include <cstddef>
+
+namespace microECS {
+
+/**
+ * @brief The limits of a fixed-capacity World, see `World(const WorldCapacity&)`.
+ *
+ * All memory of such a world comes from one slab of `slabBytes` that is allocated when the
+ * world is constructed. Pools get their full capacity and entity index when they are
+ * created, so once every component type is registered, creating and destroying entities and
+ * adding and removing components never allocate.
+ *
+ * @tparam Traits The ID types of the World, see `IDTraits`.
+ */
+template <typename Traits>
+struct BasicWorldCapacity {
+    using EntityID = typename Traits::EntityID;
+
+    EntityID maxEntities = 0; // Entity IDs that can exist at the same time
+    size_t poolCapacity = 0;  // Components every pool can hold
+    size_t slabBytes = 0;     // Size of the slab all memory of the world comes from
+
+    /**
+     * @brief Returns limits with a slab large enough for the pools of `Ts`, including a
+     * distinct value per component for shared ones and the buffers `View::EachGroup` sorts
+     * them in, plus `extraBytes` for entity names, singletons and other bookkeeping.
+     *
+     * @tparam Ts Every component type the world will use.
+     * @param maxEntities Entity IDs that can exist at the same time.
+     * @param poolCapacity Components every pool can hold.
+     * @param extraBytes Headroom for everything that is not a pool.
+     */
+    template <typename... Ts>
+    static BasicWorldCapacity For(EntityID maxEntities, size_t poolCapacity,
+                                  size_t extraBytes = 64 * 1024) {
+        constexpr size_t PAGE_SIZE = Traits::SPARSE_PAGE_SIZE;
+        constexpr size_t PAGE_BYTES = PAGE_SIZE * sizeof(typename Traits::EntityIndex);
+
+        size_t pages = (static_cast<size_t>(maxEntities) + PAGE_SIZE - 1) / PAGE_SIZE;
+        size_t perPool = pages * (PAGE_BYTES + 64) +       // Sparse index
+                         poolCapacity * sizeof(EntityID) + // Dense entities
+                         512;                              // Pool object
+
+        // A shared value has a reference count, a hash, a chain link and up to two buckets.
+        // A patch acquires its new value before it releases the old one.
+        size_t sharedValues = poolCapacity + 1;
+        size_t perValue = sizeof(size_t) + sizeof(uint64_t) + sizeof(SharedIndex) * 3;
+        size_t groupScratch = poolCapacity * (sizeof(SharedIndex) + sizeof(size_t) +
+                                              sizeof(EntityID));
+
+        BasicWorldCapacity capacity;
+        capacity.maxEntities = maxEntities;
+        capacity.poolCapacity = poolCapacity;
+        // SoA pools are cache-line aligned
+        capacity.slabBytes = ((poolCapacity * sizeof(Ts) + (IS_SOA<Ts> ? 64 : alignof(Ts)) +
+                               perPool) +
+                              ... + 0) +
+                             ((IS_SHARED<Ts> ? sharedValues * (sizeof(Ts) + perValue) +
+                                                   sizeof(Ts) + 16 * sizeof(SharedIndex)
+                                             : 0) +
+                              ... + 0) +
+                             ((IS_SHARED<Ts> || ...) ? groupScratch : 0) +
+                             maxEntities * sizeof(EntityID) * 2 + // Entity records, scratch
+                             maxEntities / 8 + extraBytes;
+        return capacity;
+    }
+};
+
+using WorldCapacity = BasicWorldCapacity<DefaultIDTraits>;
+
+} // namespace microECS
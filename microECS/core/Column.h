@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Types.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace microECS {
+
+/**
+ * @brief Who owns a buffer handed to `World::ImportColumn`.
+ */
+enum class Ownership : uint8_t {
+    Copy,   // The data is copied into the pool with a single memcpy
+    Borrow, // The pool uses the buffer in place; it must outlive the pool or its first growth
+    Adopt   // The pool takes the buffer and frees it; it must come from
+            // `::operator new(bytes, std::align_val_t(alignof(T)))`
+};
+
+/**
+ * @class Column
+ * @brief A read-only view of the dense array of one component pool.
+ * `Data()[i]` belongs to the entity `Entities()[i]`. The column is invalidated by any
+ * structural change to the pool.
+ *
+ * @tparam T The component type.
+ * @tparam Traits The ID types of the World, see `IDTraits`.
+ */
+template <typename T, typename Traits = DefaultIDTraits>
+class Column {
+public:
+    using EntityID = typename Traits::EntityID;
+
+    Column(const T* data, const EntityID* entities, size_t size)
+        : m_pData(data), m_pEntities(entities), m_Size(size) {}
+
+    const T* Data() const { return m_pData; }
+    const EntityID* Entities() const { return m_pEntities; }
+    size_t Size() const { return m_Size; }
+    bool Empty() const { return m_Size == 0; }
+
+    const T* begin() const { return m_pData; }
+    const T* end() const { return m_pData + m_Size; }
+    const T& operator[](size_t index) const { return m_pData[index]; }
+
+private:
+    const T* m_pData;
+    const EntityID* m_pEntities;
+    size_t m_Size;
+};
+
+} // namespace microECS
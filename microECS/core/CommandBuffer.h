@@ -0,0 +1,150 @@
+#pragma once
+
+#include "Memory.h"
+#include "Registry.h"
+#include "Types.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+
+namespace microECS {
+
+/**
+ * @class BasicCommandBuffer
+ * @brief Records structural changes on another thread, to be applied by the main thread.
+ *
+ * Component values are copied into a byte blob when they are recorded. Component types are
+ * only resolved to their ComponentID when the buffer is applied, so recording never touches
+ * the World. Together with `World::ReserveEntity`, this lets a loading thread create fully
+ * built entities while the main thread keeps simulating:
+ *
+ * @code
+ * // Streaming thread
+ * microECS::EntityID id = world.ReserveEntity();
+ * commands.Set(id, Position { 1.0f, 2.0f });
+ *
+ * // Main thread, after the streaming thread handed `commands` over
+ * world.Apply(commands);
+ * @endcode
+ *
+ * @warning A command buffer is not thread-safe; give each thread its own. It allocates from
+ * its own memory resource, since the World's resource may not be thread-safe.
+ */
+template <typename Traits>
+class BasicCommandBuffer {
+public:
+    using EntityID = typename Traits::EntityID;
+    using Registry = BasicRegistry<Traits>;
+
+    explicit BasicCommandBuffer(
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : m_Commands(resource), m_Data(resource) {}
+
+    /**
+     * @brief Records setting a component of an entity, adding it if the entity lacks it.
+     *
+     * @tparam T The component type.
+     * @param entityID The entity, usually from `World::ReserveEntity`.
+     * @param value The value to copy.
+     * @return The buffer, for chaining.
+     */
+    template <typename T>
+    BasicCommandBuffer& Set(EntityID entityID, const T& value) {
+        m_Commands.push_back({ &SetComponent<T>, entityID, m_Data.size() });
+        m_Data.resize(m_Data.size() + sizeof(T));
+        memcpy(m_Data.data() + m_Commands.back().offset, &value, sizeof(T));
+        return *this;
+    }
+
+    /**
+     * @brief Records adding a component with its default value.
+     *
+     * @tparam T The component type.
+     * @return The buffer, for chaining.
+     */
+    template <typename T>
+    BasicCommandBuffer& Add(EntityID entityID) {
+        T defaultValue {};
+        return Set<T>(entityID, defaultValue);
+    }
+
+    /**
+     * @brief Records removing a component from an entity.
+     *
+     * @tparam T The component type.
+     * @return The buffer, for chaining.
+     */
+    template <typename T>
+    BasicCommandBuffer& Remove(EntityID entityID) {
+        m_Commands.push_back({ &RemoveComponent<T>, entityID, m_Data.size() });
+        return *this;
+    }
+
+    /**
+     * @brief Records destroying an entity.
+     *
+     * @return The buffer, for chaining.
+     */
+    BasicCommandBuffer& Destroy(EntityID entityID) {
+        m_Commands.push_back({ &DestroyEntity, entityID, m_Data.size() });
+        return *this;
+    }
+
+    /**
+     * @brief Applies the commands in the order they were recorded and empties the buffer.
+     * IDs reserved so far become entities first. Commands for entities that are not valid by
+     * the time they run are skipped. Called by `World::Apply`.
+     */
+    void Apply(Registry& registry) {
+        registry.FlushReservedEntities();
+        for (const Command& command : m_Commands) {
+            if (registry.ValidEntity(command.entityID)) {
+                command.apply(registry, command.entityID, m_Data.data() + command.offset);
+            }
+        }
+        Clear();
+    }
+
+    /**
+     * @brief Drops every command. The buffer keeps its memory for reuse.
+     */
+    void Clear() {
+        m_Commands.clear();
+        m_Data.clear();
+    }
+
+    size_t GetCommandCount() const { return m_Commands.size(); }
+    bool IsEmpty() const { return m_Commands.empty(); }
+
+private:
+    using ApplyFunc = void (*)(Registry&, EntityID, const void*);
+
+    struct Command {
+        ApplyFunc apply;
+        EntityID entityID;
+        size_t offset; // Into m_Data
+    };
+
+    template <typename T>
+    static void SetComponent(Registry& registry, EntityID entityID, const void* data) {
+        registry.SetComponent(entityID, registry.template GetComponentID<T>(), data);
+    }
+
+    template <typename T>
+    static void RemoveComponent(Registry& registry, EntityID entityID, const void*) {
+        registry.RemoveComponent(entityID, registry.template GetComponentID<T>());
+    }
+
+    static void DestroyEntity(Registry& registry, EntityID entityID, const void*) {
+        registry.DestroyEntity(entityID);
+    }
+
+private:
+    Vector<Command> m_Commands;
+    Vector<uint8_t> m_Data;
+};
+
+using CommandBuffer = BasicCommandBuffer<DefaultIDTraits>;
+
+} // namespace microECS
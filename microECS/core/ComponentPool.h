@@ -1,50 +1,231 @@
 #pragma once
 
 #include "Assert.h"
+#include "Column.h"
+#include "Memory.h"
+#include "Policy.h"
+#include "Profile.h"
+#include "Shared.h"
+#include "SoA.h"
+#include "SparseIndex.h"
+#include "Stats.h"
+#include "Trace.h"
 #include "Types.h"
 
 #include <cstdint>
+#include <cstring>
+#include <memory_resource>
 #include <new>
 #include <string>
-#include <unordered_map>
-#include <vector>
 
 namespace microECS {
 /**
- * @class ComponentPool
+ * @class BasicComponentPool
  * @brief A class that represents a pool of components for an ECS (Entity-Component-System) architecture.
  *
  * The ComponentPool class provides functionality to add, set, retrieve, and check components for entities.
  * It manages the memory allocation and deallocation for the component pool, as well as the mapping between entities and components.
+ * All of its memory comes from the `std::pmr::memory_resource` it was created with.
+ *
+ * A pool with a component size of 0 holds a tag (an empty type): it only tracks which entities
+ * have the tag and allocates no component storage.
+ *
+ * A pool with a field layout (see `SetFieldLayout`) stores its components as a structure of
+ * arrays: one block holds a column per field, each column `capacity` fields long. Components
+ * are still passed in and out as packed values; only pointers to single components are not
+ * available, use `GetFieldData` instead.
+ *
+ * A shared pool (see `MakeShared`) keeps one copy of every distinct value in a
+ * `SharedValueStore`, and a `SharedIndex` per component. Components are passed in and out as
+ * packed values too, but they can only be read in place.
+ *
+ * @tparam Traits The ID types, see `IDTraits`. With generations, an entity only counts as
+ * present if its full ID matches the one in the dense entity array.
  */
-class ComponentPool {
+template <typename Traits>
+class BasicComponentPool {
 public:
-    ComponentPool(size_t size, size_t alignment, const std::string& name)
-        : m_ComponentSize(size), m_Alignment(alignment), m_Name(name), m_Count(0) {
+    using EntityID = typename Traits::EntityID;
+    using SparseIndex = BasicSparseIndex<Traits>;
+
+    BasicComponentPool(size_t size, size_t alignment, const std::string& name,
+                  std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : m_pResource(resource), m_ComponentSize(size), m_Alignment(alignment),
+          m_Name(name.data(), name.size(), resource), m_Count(0), m_EntityToComponentMap(resource),
+          m_ComponentToEntityMap(resource), m_Fields(resource),
+          m_SharedValues(size, alignment, resource) {
 
-        ASSERT(size > 0, "Component size must be greater than 0.");
         ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0,
                "Alignment must be a power of two.");
 
         m_pComponents = AllocateComponentPool(size, alignment);
     }
 
+    /**
+     * @brief Deep-copies a pool. The copy always owns its memory, even if `other` is mapped,
+     * and allocates from the same memory resource.
+     */
+    BasicComponentPool(const BasicComponentPool& other)
+        : m_pResource(other.m_pResource), m_ComponentSize(other.m_ComponentSize),
+          m_Count(other.m_Count), m_PoolSize(other.m_PoolSize), m_Alignment(other.m_Alignment),
+          m_Name(other.m_Name),
+          m_EntityToComponentMap(other.m_EntityToComponentMap),
+          m_ComponentToEntityMap(other.m_ComponentToEntityMap), m_Sorted(other.m_Sorted),
+          m_Version(other.m_Version), m_StructureVersion(other.m_StructureVersion),
+          m_HighWaterMark(other.m_HighWaterMark), m_ResizeCount(other.m_ResizeCount),
+          m_FixedCapacity(other.m_FixedCapacity), m_ShrinkPolicy(other.m_ShrinkPolicy),
+          m_GrowthPolicy(other.m_GrowthPolicy), m_AddsThisFrame(other.m_AddsThisFrame),
+          m_AddRate(other.m_AddRate), m_Fields(other.m_Fields), m_Shared(other.m_Shared),
+          m_SharedValues(other.m_SharedValues), m_pIndexOwner(other.m_pIndexOwner) {
+        MECS_PROFILE(m_Access = other.m_Access);
+        m_pComponents = AllocateStorage(m_PoolSize);
+        other.CopyStorage(m_pComponents, m_PoolSize);
+    }
+
+    BasicComponentPool& operator=(const BasicComponentPool&) = delete;
+
+    ~BasicComponentPool() { DeallocateComponentPool(); }
+
     /**
      * @brief Adds the component data to the specified entity.
      *
      * @param entityID The ID of the entity to add the component to.
      * @param componentData A pointer to the component data to be added.
-     * @return A void pointer to the added component.
+     * @return A void pointer to the added component, or nullptr if the pool is at its
+     * fixed capacity.
      */
     void* AddComponent(EntityID entityID, const void* componentData) {
         ASSERT(componentData != nullptr, "Component data cannot be null.");
+        if (!HasRoomFor(1)) {
+            return nullptr;
+        }
+
+        MarkModified();
+        m_StructureVersion++;
 
-        m_EntityToComponentMap[entityID] = m_Count;
+        SetIndex(entityID, m_Count);
         m_ComponentToEntityMap.push_back(entityID);
 
         return AddComponentToPool(componentData);
     }
 
+    /**
+     * @brief Adds the same component data to many entities at once.
+     * The pool and the entity maps grow at most once, then are filled in a tight loop.
+     *
+     * @param entityIDs The entities to add the component to. None of them may have it yet.
+     * @param count The number of entities.
+     * @param componentData A pointer to the component data copied to every entity.
+     * @return `false` if the components do not fit in a fixed-capacity pool. Nothing is added then.
+     */
+    bool AddComponents(const EntityID* entityIDs, size_t count, const void* componentData) {
+        ASSERT(componentData != nullptr, "Component data cannot be null.");
+        if (count == 0) {
+            return true;
+        }
+        if (!HasRoomFor(count)) {
+            return false;
+        }
+
+        MarkModified();
+        m_StructureVersion++;
+        if (m_Count + count > m_PoolSize) {
+            Grow(m_Count + count);
+        }
+        m_AddsThisFrame += count;
+
+        ReserveIndex(entityIDs, count);
+        m_ComponentToEntityMap.insert(m_ComponentToEntityMap.end(), entityIDs, entityIDs + count);
+
+        for (size_t i = 0; i < count; i++) {
+            ASSERT(!HasEntity(entityIDs[i]), "Entity already has this component.");
+            SetIndex(entityIDs[i], m_Count + i);
+        }
+
+        // Copy the component once, then keep doubling the filled range,
+        // so large batches take O(log count) memcpy calls (per column for SoA pools)
+        if (IsSoA()) {
+            const uint8_t* source = static_cast<const uint8_t*>(componentData);
+            for (size_t f = 0; f < m_Fields.size(); f++) {
+                const FieldLayout& field = m_Fields[f];
+                Fill(ColumnData(f) + m_Count * field.size, source + field.offset, field.size,
+                     count);
+            }
+        } else if (IsShared()) {
+            SharedIndex value = m_SharedValues.Acquire(componentData, count);
+            Fill(reinterpret_cast<uint8_t*>(SharedSlots() + m_Count), &value, sizeof(SharedIndex),
+                 count);
+        } else {
+            Fill(static_cast<uint8_t*>(m_pComponents) + m_Count * m_ComponentSize, componentData,
+                 m_ComponentSize, count);
+        }
+
+        m_Count += count;
+        UpdateHighWaterMark();
+        return true;
+    }
+
+    /**
+     * @brief Makes sure the pool can hold `capacity` components without growing.
+     *
+     * @param capacity The number of components to make room for.
+     * @return `false` if `capacity` is larger than the fixed capacity of the pool.
+     */
+    bool Reserve(size_t capacity) {
+        if (capacity > m_PoolSize && !ResizeComponentPool(capacity)) {
+            return false;
+        }
+        m_ComponentToEntityMap.reserve(capacity);
+        return true;
+    }
+
+    /**
+     * @brief Turns the pool into a fixed-capacity pool. Its storage and its entity index are
+     * allocated for the whole capacity right away, and the pool never grows or shrinks again.
+     *
+     * @param capacity The number of components the pool can hold.
+     * @param maxEntities The number of entity IDs to index, so adding never allocates a page.
+     * @return `false` if the pool already holds more than `capacity` components.
+     */
+    bool MakeFixed(size_t capacity, EntityID maxEntities) {
+        ASSERT(capacity > 0, "Fixed capacity must be greater than 0.");
+        if (m_Count > capacity) {
+            return false;
+        }
+
+        if (m_PoolSize != capacity || m_Mapped) {
+            m_FixedCapacity = 0;
+            ResizeComponentPool(capacity);
+        }
+        m_FixedCapacity = capacity;
+
+        m_ComponentToEntityMap.reserve(capacity);
+        if (maxEntities > 0 && m_pIndexOwner == nullptr) {
+            m_EntityToComponentMap.Reserve(0, maxEntities - 1);
+        }
+        ReserveSharedValues();
+        return true;
+    }
+
+    /**
+     * @brief Checks if the pool was made fixed-capacity with `MakeFixed`.
+     */
+    bool IsFixedCapacity() const { return m_FixedCapacity > 0; }
+
+    /**
+     * @brief Returns how many more components fit without allocating.
+     * For a fixed-capacity pool this is a hard limit, otherwise the pool grows when it is reached.
+     */
+    size_t GetRemainingCapacity() const { return m_PoolSize > m_Count ? m_PoolSize - m_Count : 0; }
+
+    /**
+     * @brief Checks if `count` more components can be added.
+     * Always `true` for pools that are not fixed-capacity.
+     */
+    bool HasRoomFor(size_t count) const {
+        return m_FixedCapacity == 0 || m_Count + count <= m_FixedCapacity;
+    }
+
     /**
      * @brief Sets the component data for the specified entity.
      *
@@ -53,28 +234,149 @@ public:
      */
     void SetComponent(EntityID entityID, const void* componentData) {
         ASSERT(componentData != nullptr, "Component data cannot be null.");
+        MarkModified();
+        MECS_PROFILE(m_Access.writes++);
 
-        size_t index = m_EntityToComponentMap[entityID];
+        size_t index = Index().Get(entityID);
+        ASSERT(index != SparseIndex::INVALID_INDEX, "Entity does not have this component.");
         OverwriteComponentData(index, componentData);
     }
 
     void RemoveComponent(EntityID entityID) {
-        size_t index = m_EntityToComponentMap[entityID];
+        MarkModified();
+        m_StructureVersion++;
+        size_t index = Index().Get(entityID);
+        ASSERT(index != SparseIndex::INVALID_INDEX, "Entity does not have this component.");
 
         RemoveComponentFromPool(index);
 
         // If component is not the last element
         if (index != m_ComponentToEntityMap.size() - 1) {
             // Swap the last component with the removed one
-            size_t lastEntityID = m_ComponentToEntityMap.back();
-            m_ComponentToEntityMap[index] = static_cast<EntityID>(lastEntityID);
-            m_EntityToComponentMap[lastEntityID] = index;
+            EntityID lastEntityID = m_ComponentToEntityMap.back();
+            m_ComponentToEntityMap[index] = lastEntityID;
+            SetIndex(lastEntityID, index);
         }
 
-        m_EntityToComponentMap.erase(entityID);
+        EraseIndex(entityID);
         m_ComponentToEntityMap.pop_back();
+
+        ShrinkIfSparse();
+    }
+
+    /**
+     * @brief Removes every component from the pool at once.
+     * Resets the count, truncates the dense-to-entity array and wipes the entity index
+     * in O(pages) instead of doing a swap-and-pop per entity.
+     *
+     * @param keepCapacity If `true`, the component storage and index pages are kept so the
+     * pool can be refilled without reallocating. Otherwise the pool goes back to its initial size.
+     */
+    void Clear(bool keepCapacity = true) {
+        // Fixed-capacity pools never give their memory back
+        keepCapacity = keepCapacity || m_FixedCapacity > 0;
+
+        // No need to copy read-only mapped data just to throw it away
+        if (m_ReadOnly || (!keepCapacity && m_PoolSize > INIT_COMPONENT_POOL_SIZE)) {
+            DeallocateComponentPool();
+            m_pComponents = AllocateComponentPool(m_ComponentSize, m_Alignment);
+        }
+
+        m_EntityToComponentMap.Clear(keepCapacity);
+        m_ComponentToEntityMap.clear();
+        if (!keepCapacity) {
+            m_ComponentToEntityMap.shrink_to_fit();
+        }
+        m_SharedValues.Clear();
+
+        m_Count = 0;
+        m_Sorted = false;
+        m_Version++;
+        m_StructureVersion++;
+    }
+
+    /**
+     * @brief Removes the components of every entity flagged in `dead`.
+     * Surviving components are compacted in a single pass and keep their relative order.
+     *
+     * @param dead Flags indexed by entity index; indices past the end count as alive.
+     */
+    void RemoveComponents(const Vector<bool>& dead) {
+        MarkModified();
+        m_StructureVersion++;
+
+        size_t write = 0;
+        for (size_t read = 0; read < m_Count; read++) {
+            EntityID entityID = m_ComponentToEntityMap[read];
+            size_t index = Traits::GetIndex(entityID);
+            if (index < dead.size() && dead[index]) {
+                EraseIndex(entityID);
+                if (IsShared()) {
+                    m_SharedValues.Release(SharedSlots()[read]);
+                }
+                continue;
+            }
+
+            if (write != read) {
+                MoveComponent(write, read);
+                m_ComponentToEntityMap[write] = entityID;
+                SetIndex(entityID, write);
+            }
+            write++;
+        }
+
+        m_Count = write;
+        m_ComponentToEntityMap.resize(write);
+
+        ShrinkIfSparse();
+    }
+
+    /**
+     * @brief Sets when the pool gives memory back after removals, see `ShrinkPolicy`.
+     */
+    void SetShrinkPolicy(const ShrinkPolicy& policy) {
+        ASSERT(policy.threshold > 0.0f && policy.threshold < policy.target &&
+                   policy.target <= 1.0f,
+               "Shrink policy needs 0 < threshold < target <= 1.");
+        m_ShrinkPolicy = policy;
+    }
+
+    const ShrinkPolicy& GetShrinkPolicy() const { return m_ShrinkPolicy; }
+
+    /**
+     * @brief Sets how the pool grows when it is full, see `GrowthPolicy`.
+     */
+    void SetGrowthPolicy(const GrowthPolicy& policy) {
+        ASSERT(policy.mode == GrowthPolicy::Mode::FixedStep ? policy.step > 0
+                                                             : policy.factor > 1.0f,
+               "Growth policy needs a step > 0 or a factor > 1.");
+        m_GrowthPolicy = policy;
     }
 
+    const GrowthPolicy& GetGrowthPolicy() const { return m_GrowthPolicy; }
+
+    /**
+     * @brief Closes the current frame for the adaptive growth policy: the adds counted since
+     * the last call update the observed adds per frame. A spike is taken over right away,
+     * while a quieter frame only pulls the rate halfway down.
+     */
+    void EndFrame() {
+        float adds = static_cast<float>(m_AddsThisFrame);
+        m_AddRate = adds > m_AddRate ? adds : (m_AddRate + adds) * 0.5f;
+        m_AddsThisFrame = 0;
+    }
+
+    /**
+     * @brief Returns the observed number of adds per frame, see `EndFrame`.
+     */
+    float GetAddRate() const { return m_AddRate; }
+
+    /**
+     * @brief Shrinks the dense arrays to the live components and frees empty index pages.
+     * Does nothing for fixed-capacity pools; mapped pools only shrink their index.
+     */
+    void ShrinkToFit() { Shrink(m_Count > 0 ? m_Count : 1); }
+
     /**
      * @brief Retrieves the component data associated with the specified entity ID.
      * The component data is returned as a constant pointer to the component.
@@ -83,7 +385,13 @@ public:
      * @return A constant pointer to the component associated with the entity ID, or nullptr if the component does not exist.
      */
     const void* GetComponent(EntityID entityID) const {
-        size_t index = m_EntityToComponentMap.at(entityID);
+        ASSERT(!IsSoA(), "SoA components have no contiguous value.");
+        MECS_PROFILE(m_Access.reads++);
+        size_t index = Index().Get(entityID);
+        ASSERT(index != SparseIndex::INVALID_INDEX, "Entity does not have this component.");
+        if (IsShared()) {
+            return m_SharedValues.Get(SharedSlots()[index]);
+        }
         return static_cast<uint8_t*>(m_pComponents) + index * m_ComponentSize;
     }
 
@@ -95,7 +403,12 @@ public:
      * @return A mutable pointer to the component associated with the entity ID, or nullptr if the component does not exist.
      */
     void* GetMutComponent(EntityID entityID) {
-        size_t index = m_EntityToComponentMap.at(entityID);
+        ASSERT(!IsSoA(), "SoA components have no contiguous value.");
+        ASSERT(!IsShared(), "Shared components are read in place, set a new value instead.");
+        MarkModified();
+        MECS_PROFILE(m_Access.writes++);
+        size_t index = Index().Get(entityID);
+        ASSERT(index != SparseIndex::INVALID_INDEX, "Entity does not have this component.");
         return static_cast<uint8_t*>(m_pComponents) + index * m_ComponentSize;
     }
 
@@ -106,7 +419,12 @@ public:
      * @return `true` if the component pool contains the entity, `false` otherwise.
      */
     bool HasEntity(EntityID entityID) const {
-        return m_EntityToComponentMap.find(entityID) != m_EntityToComponentMap.end();
+        if constexpr (Traits::GENERATION_BITS == 0) {
+            return Index().Contains(entityID);
+        } else {
+            size_t index = Index().Get(entityID);
+            return index != SparseIndex::INVALID_INDEX && m_ComponentToEntityMap[index] == entityID;
+        }
     }
 
     size_t GetCount() const { return m_Count; }
@@ -121,17 +439,512 @@ public:
 
     /**
      * Returns a pointer to the underlying data array.
+     * For SoA pools this is the block of columns, see `GetFieldData`, and for shared pools
+     * the `SharedIndex` of every component.
      *
      * @return A void pointer to the underlying data array.
      */
-    void* Data() { return m_pComponents; }
+    void* Data() {
+        MarkModified();
+        return m_pComponents;
+    }
+
+    /**
+     * Returns a read-only pointer to the underlying data array.
+     * Unlike `Data()`, this never promotes a read-only mapped pool.
+     *
+     * @return A constant void pointer to the underlying data array.
+     */
+    const void* Data() const { return m_pComponents; }
+
+    size_t GetComponentSize() const { return m_ComponentSize; }
+
+    /**
+     * @brief Checks if the pool holds a tag, a component without data.
+     */
+    bool IsTag() const { return m_ComponentSize == 0; }
+
+    /**
+     * @brief Checks if the pool stores its components as a structure of arrays.
+     */
+    bool IsSoA() const { return !m_Fields.empty(); }
+
+    /**
+     * @brief Checks if the pool keeps one copy of every distinct value, see `MakeShared`.
+     */
+    bool IsShared() const { return m_Shared; }
+
+    /**
+     * @brief Checks if the storage is the packed array of components, which is not the case
+     * for SoA and shared pools.
+     */
+    bool IsPacked() const { return !IsSoA() && !IsShared(); }
+
+    /**
+     * @brief Switches the pool to shared storage: one copy of every distinct value, and a
+     * `SharedIndex` per component. Components already in the pool are deduplicated; mapped
+     * or borrowed storage is copied to owned memory.
+     */
+    void MakeShared() {
+        ASSERT(!IsTag() && IsPacked(), "Only packed data pools can share their values.");
+
+        Vector<uint8_t> packed(m_Count * m_ComponentSize, m_Fields.get_allocator());
+        ReadComponents(packed.data());
+        DeallocateComponentPool();
+
+        m_Shared = true;
+        m_pComponents = AllocateStorage(m_PoolSize);
+        ReserveSharedValues();
+        WritePacked(packed.data(), m_Count);
+        m_Version++;
+    }
+
+    const SharedValueStore& GetSharedValues() const { return m_SharedValues; }
+
+    /**
+     * @brief Returns the index of the value of the component at dense index `index`
+     * in a shared pool.
+     */
+    SharedIndex GetSharedIndex(size_t index) const { return SharedSlots()[index]; }
+
+    /**
+     * @brief Switches the pool to structure-of-arrays storage. Components already in the pool
+     * are moved into the columns; mapped or borrowed storage is copied to owned memory.
+     * Columns are ordered by decreasing field alignment and the block is cache-line aligned,
+     * so every column starts at least at its field's alignment.
+     *
+     * @param fields The fields of the component, see `SoAFields`. Their columns are filled in.
+     * @param count The number of fields.
+     */
+    void SetFieldLayout(const FieldLayout* fields, size_t count) {
+        ASSERT(!IsTag() && IsPacked() && count > 0, "Only data pools can switch to SoA storage.");
+
+        Vector<FieldLayout> layout(fields, fields + count, m_Fields.get_allocator());
+        size_t bytes = 0;
+        for (size_t alignment = COLUMN_ALIGNMENT; alignment > 0; alignment /= 2) {
+            for (FieldLayout& field : layout) {
+                if (field.alignment == alignment) {
+                    field.column = bytes;
+                    bytes += field.size;
+                }
+            }
+        }
+        ASSERT(bytes <= m_ComponentSize, "SoA fields do not fit in the component.");
+
+        Vector<uint8_t> packed(m_Count * m_ComponentSize, m_Fields.get_allocator());
+        if (m_Count > 0) {
+            memcpy(packed.data(), m_pComponents, packed.size());
+        }
+        DeallocateComponentPool();
+
+        m_Fields = std::move(layout);
+        m_pComponents = AllocateStorage(m_PoolSize);
+        WritePacked(packed.data(), m_Count);
+        m_Version++;
+    }
+
+    size_t GetFieldCount() const { return m_Fields.size(); }
+    const FieldLayout* GetFields() const { return m_Fields.data(); }
+
+    /**
+     * @brief Returns the column of one field of an SoA pool: the field of the component at
+     * dense index `i` is element `i`. Counts as a write, like `Data()`.
+     *
+     * @param field The field, in the order of the layout.
+     */
+    void* GetFieldData(size_t field) {
+        MarkModified();
+        return ColumnData(field);
+    }
+
+    const void* GetFieldData(size_t field) const { return ColumnData(field); }
+
+    /**
+     * @brief Copies every component, in dense order, as packed values to `out`, which has
+     * room for `GetCount()` components. For SoA pools this gathers the columns, and bytes
+     * that belong to no field are zero. Shared pools copy the value of every component.
+     */
+    void ReadComponents(void* out) const {
+        // Tags have no bytes to copy, and `out` may be null for them
+        if (m_Count == 0 || IsTag()) {
+            return;
+        }
+        if (IsShared()) {
+            uint8_t* destination = static_cast<uint8_t*>(out);
+            for (size_t i = 0; i < m_Count; i++) {
+                memcpy(destination + i * m_ComponentSize, m_SharedValues.Get(SharedSlots()[i]),
+                       m_ComponentSize);
+            }
+            return;
+        }
+        if (!IsSoA()) {
+            memcpy(out, m_pComponents, m_Count * m_ComponentSize);
+            return;
+        }
+
+        uint8_t* destination = static_cast<uint8_t*>(out);
+        memset(destination, 0, m_Count * m_ComponentSize);
+        for (size_t f = 0; f < m_Fields.size(); f++) {
+            const FieldLayout& field = m_Fields[f];
+            const uint8_t* column = ColumnData(f);
+            for (size_t i = 0; i < m_Count; i++) {
+                memcpy(destination + i * m_ComponentSize + field.offset, column + i * field.size,
+                       field.size);
+            }
+        }
+    }
+
+    /**
+     * @brief Overwrites `length` bytes of a component, starting `offset` bytes into it.
+     *
+     * @param entityID The entity whose component is patched.
+     * @param offset The first byte to write, relative to the packed component.
+     * @param data The new bytes.
+     * @param length The number of bytes.
+     */
+    void PatchComponent(EntityID entityID, size_t offset, const void* data, size_t length) {
+        MarkModified();
+        MECS_PROFILE(m_Access.writes++);
+        size_t index = Index().Get(entityID);
+        ASSERT(index != SparseIndex::INVALID_INDEX, "Entity does not have this component.");
+        ASSERT(offset + length <= m_ComponentSize, "Patch is out of the component.");
+
+        const uint8_t* source = static_cast<const uint8_t*>(data);
+        if (IsShared()) {
+            // The patched value is a new value, the old one stays as it is for other entities
+            SharedIndex previous = SharedSlots()[index];
+            SharedSlots()[index] = m_SharedValues.AcquirePatched(previous, offset, source, length);
+            m_SharedValues.Release(previous);
+            return;
+        }
+        if (!IsSoA()) {
+            memcpy(static_cast<uint8_t*>(m_pComponents) + index * m_ComponentSize + offset,
+                   source, length);
+            return;
+        }
+
+        // Only the part of the patch that overlaps each field lands in its column
+        for (size_t f = 0; f < m_Fields.size(); f++) {
+            const FieldLayout& field = m_Fields[f];
+            size_t first = offset > field.offset ? offset : field.offset;
+            size_t last = offset + length < field.offset + field.size ? offset + length
+                                                                      : field.offset + field.size;
+            if (first < last) {
+                memcpy(ColumnData(f) + index * field.size + (first - field.offset),
+                       source + (first - offset), last - first);
+            }
+        }
+    }
+
+    size_t GetAlignment() const { return m_Alignment; }
+    std::pmr::memory_resource* GetMemoryResource() const { return m_pResource; }
+
+    /**
+     * @brief Returns the number of components the pool can hold before it has to grow.
+     */
+    size_t GetCapacity() const { return m_PoolSize; }
+
+    /**
+     * @brief Reports the memory use and occupancy of the pool.
+     *
+     * @return The statistics of this pool.
+     */
+    PoolStats GetStats() const {
+        PoolStats stats;
+        stats.name = GetName();
+        stats.componentSize = m_ComponentSize;
+        stats.capacity = m_PoolSize;
+        stats.count = m_Count;
+        stats.highWaterMark = m_HighWaterMark;
+        stats.resizeCount = m_ResizeCount;
+        stats.addRate = m_AddRate;
+        stats.denseBytes = m_Mapped ? 0 : m_PoolSize * SlotSize();
+        stats.mappedBytes = m_Mapped ? m_PoolSize * SlotSize() : 0;
+        if (IsShared()) {
+            stats.denseBytes += m_SharedValues.GetMemoryUsage();
+            stats.sharedValueCount = m_SharedValues.GetValueCount();
+        }
+        stats.indexBytes = m_EntityToComponentMap.GetMemoryUsage() +
+                           m_ComponentToEntityMap.capacity() * sizeof(EntityID);
+        return stats;
+    }
+
+#if defined(MECS_ENABLE_PROFILE)
+    /**
+     * @brief Records a pass of a view or field span over the pool, see `PoolAccessCounters`.
+     * Counters are bookkeeping, not pool state, so they can be updated through a const pool.
+     */
+    void RecordPass(size_t visited, uint64_t fields) const { m_Access.RecordPass(visited, fields); }
+
+    const PoolAccessCounters& GetAccessCounters() const { return m_Access; }
+
+    void ResetAccessCounters() const { m_Access = PoolAccessCounters(); }
+#endif
+
+    /**
+     * @brief Rearranges the pool into the dense order of `owner`, so that it can share its
+     * entity index (see `ShareIndex`). Components of entities that `owner` does not have are
+     * dropped, and entities that only `owner` has get a copy of `defaultValue`.
+     */
+    void AlignTo(const BasicComponentPool& owner, const void* defaultValue) {
+        ASSERT(m_pIndexOwner == nullptr, "The pool already shares an index.");
+        if (m_ComponentToEntityMap == owner.m_ComponentToEntityMap) {
+            return;
+        }
+
+        Vector<uint8_t> current(m_Count * m_ComponentSize, m_Fields.get_allocator());
+        ReadComponents(current.data());
+
+        size_t count = owner.m_Count;
+        Vector<uint8_t> aligned(count * m_ComponentSize, m_Fields.get_allocator());
+        for (size_t i = 0; i < count; i++) {
+            EntityID entityID = owner.m_ComponentToEntityMap[i];
+            const void* source =
+                HasEntity(entityID)
+                    ? current.data() + m_EntityToComponentMap.Get(entityID) * m_ComponentSize
+                    : defaultValue;
+            memcpy(aligned.data() + i * m_ComponentSize, source, m_ComponentSize);
+        }
+
+        Clear(true);
+        if (count > m_PoolSize) {
+            ResizeComponentPool(count);
+        }
+        WritePacked(aligned.data(), count);
+        m_Count = count;
+        m_ComponentToEntityMap.assign(owner.m_ComponentToEntityMap.begin(),
+                                      owner.m_ComponentToEntityMap.end());
+        UpdateHighWaterMark();
+    }
+
+    /**
+     * @brief Makes the pool look entities up in the index of `owner`, and releases its own.
+     * Used for the cold part of a split component (see `SplitComponent`). Both pools must have
+     * the same dense order (see `AlignTo`) and must then be changed in lockstep, this pool
+     * first, as it relies on `owner` to keep the index up to date.
+     * Passing `nullptr` gives the pool its own index again, rebuilt from its entities.
+     */
+    void ShareIndex(const BasicComponentPool* owner) {
+        m_pIndexOwner = owner;
+        m_EntityToComponentMap.Clear(false);
+        if (owner == nullptr) {
+            ReserveIndex(m_ComponentToEntityMap.data(), m_Count);
+            for (size_t i = 0; i < m_Count; i++) { SetIndex(m_ComponentToEntityMap[i], i); }
+        }
+    }
+
+    bool SharesIndex() const { return m_pIndexOwner != nullptr; }
+
+    /**
+     * @brief Points the pool at externally owned (memory-mapped or borrowed) component data.
+     * The previous storage is released. The pool does not own the new storage and
+     * will be promoted to owned memory when it first has to grow past `capacity`.
+     *
+     * @param data The first component. Must be aligned to the component alignment.
+     * @param count The number of live components at `data`.
+     * @param capacity The number of components that fit at `data`.
+     * @param readOnly If `true`, the pool copies the data to owned memory before the first write.
+     */
+    void MapComponents(void* data, size_t count, size_t capacity, bool readOnly) {
+        ASSERT(data != nullptr, "Mapped component data cannot be null.");
+        ASSERT(count <= capacity, "Mapped component count exceeds the mapped capacity.");
+        ASSERT(reinterpret_cast<uintptr_t>(data) % m_Alignment == 0,
+               "Mapped component data is not aligned to the component alignment.");
+
+        // SoA and shared pools keep their own layout, so the components are copied in
+        if (!IsPacked()) {
+            Reserve(capacity);
+            WritePacked(data, count);
+            m_Count = count;
+            UpdateHighWaterMark();
+            m_Sorted = false;
+            m_Version++;
+            return;
+        }
+
+        // There is no data to map for tags, only the count
+        if (IsTag()) {
+            Reserve(capacity);
+            m_Count = count;
+            UpdateHighWaterMark();
+            m_Sorted = false;
+            m_Version++;
+            return;
+        }
+
+        DeallocateComponentPool();
+
+        m_pComponents = data;
+        m_Count = count;
+        UpdateHighWaterMark();
+        m_PoolSize = capacity;
+        m_Mapped = true;
+        m_ReadOnly = readOnly;
+        m_Sorted = false;
+        m_Version++;
+    }
+
+    /**
+     * @brief Builds the pool around an existing packed array of components.
+     * The entity index is built in bulk; components are never copied one by one.
+     *
+     * @param entities The entity owning each component, in the same order as `data`.
+     * @param data `count` packed components.
+     * @param count The number of components.
+     * @param ownership Whether the data is copied, borrowed or adopted by the pool.
+     * @return `false` if the pool is fixed-capacity and the data does not fit, or is not copied.
+     */
+    bool ImportComponents(const EntityID* entities, void* data, size_t count,
+                          Ownership ownership) {
+        ASSERT(m_Count == 0, "Components can only be imported into an empty pool.");
+        ASSERT(data != nullptr || count == 0, "Component data cannot be null.");
+
+        // Tags have nothing to borrow or adopt, SoA pools copy into their columns and shared
+        // pools into their values. An adopted buffer is released once the pool is done with it.
+        void* adopted = nullptr;
+        if ((IsTag() || !IsPacked()) && ownership != Ownership::Copy) {
+            adopted = ownership == Ownership::Adopt ? data : nullptr;
+            ownership = Ownership::Copy;
+        }
+
+        // A fixed-capacity pool keeps its own storage
+        if (m_FixedCapacity > 0 && (ownership != Ownership::Copy || count > m_FixedCapacity)) {
+            if (adopted != nullptr) {
+                ::operator delete(adopted, std::align_val_t(m_Alignment));
+            }
+            return false;
+        }
+
+        switch (ownership) {
+            case Ownership::Copy:
+                // An empty pool from an image may still be mapped read-only
+                MarkModified();
+                Reserve(count);
+                WritePacked(data, count);
+                m_Count = count;
+                break;
+            case Ownership::Borrow:
+                MapComponents(data, count, count, false);
+                break;
+            case Ownership::Adopt:
+                DeallocateComponentPool();
+                m_pComponents = data;
+                m_Count = count;
+                m_PoolSize = count;
+                m_Adopted = true;
+                m_Version++;
+                break;
+        }
+
+        if (adopted != nullptr) {
+            ::operator delete(adopted, std::align_val_t(m_Alignment));
+        }
+
+        m_Sorted = false;
+        UpdateHighWaterMark();
+        AssignEntities(entities, count);
+        return true;
+    }
+
+    /**
+     * @brief Returns a read-only view of the dense component array and its entities.
+     *
+     * @tparam T The component type stored in this pool.
+     */
+    template <typename T>
+    Column<T, Traits> GetColumn() const {
+        ASSERT(COMPONENT_SIZE<T> == m_ComponentSize && IsPacked(),
+               "Column type does not match the component pool.");
+        return Column<T, Traits>(static_cast<const T*>(m_pComponents),
+                                 m_ComponentToEntityMap.data(), m_Count);
+    }
+
+    /**
+     * @brief Rebuilds both entity maps from a packed dense index -> entity array.
+     *
+     * @param entities The entity owning each component, in dense order.
+     * @param count The number of entries in `entities`. Must match the component count.
+     */
+    void AssignEntities(const EntityID* entities, size_t count) {
+        ASSERT(count == m_Count, "Entity count does not match component count.");
+
+        for (EntityID entityID : m_ComponentToEntityMap) { EraseIndex(entityID); }
+        m_ComponentToEntityMap.assign(entities, entities + count);
+
+        ReserveIndex(entities, count);
+        for (size_t i = 0; i < count; i++) { SetIndex(entities[i], i); }
+
+        m_StructureVersion++;
+    }
+
+    /**
+     * @brief Overwrites the pool with previously saved dense data (used by rollback).
+     *
+     * @param data `count` packed components.
+     * @param entities The entity owning each component, in dense order.
+     * @param count The number of components to restore.
+     * @param restoreEntities `false` if the entity maps are known to be unchanged since the
+     * data was saved, which skips rebuilding the index.
+     */
+    void RestoreComponents(const void* data, const EntityID* entities, size_t count,
+                           bool restoreEntities) {
+        MarkModified();
+        if (count > m_PoolSize) {
+            ResizeComponentPool(count);
+        }
+
+        WritePacked(data, count);
+        m_Count = count;
+        UpdateHighWaterMark();
+        m_Sorted = false;
+
+        if (restoreEntities) {
+            AssignEntities(entities, count);
+        }
+    }
+
+    /**
+     * @brief Returns a counter that changes whenever the component data may have been written.
+     * Any mutable access (`GetMutComponent`, `Data`, views) counts as a write.
+     */
+    uint64_t GetVersion() const { return m_Version; }
+
+    /**
+     * @brief Returns a counter that changes whenever entities are added, removed or reordered.
+     */
+    uint64_t GetStructureVersion() const { return m_StructureVersion; }
+
+    /**
+     * @brief Flags the component data as (about to be) modified.
+     * Promotes read-only mapped storage and bumps the version.
+     */
+    void MarkModified() {
+        MakeWritable();
+        m_Version++;
+    }
+
+    /**
+     * @brief Checks if the component data lives in external memory (a file mapping or a
+     * borrowed buffer) instead of memory owned by the pool.
+     */
+    bool IsMapped() const { return m_Mapped; }
+
+    /**
+     * @brief Promotes a read-only mapped pool to owned memory so it can be written.
+     * Does nothing for owned or copy-on-write mapped pools.
+     */
+    void MakeWritable() {
+        if (m_ReadOnly) {
+            ResizeComponentPool(m_PoolSize);
+        }
+    }
 
     /**
      * @brief Get the name of the component type.
      *
      * @return `std::string` The name of the component type.
      */
-    std::string GetName() const { return m_Name; }
+    std::string GetName() const { return std::string(m_Name.data(), m_Name.size()); }
 
     /**
      * @brief Retrieves the entity ID associated with the component at the specified index.
@@ -141,18 +954,20 @@ public:
      */
     EntityID GetEntityID(size_t index) const { return m_ComponentToEntityMap[index]; }
 
-    std::unordered_map<EntityID, size_t>& GetEntities() { return m_EntityToComponentMap; }
-    std::vector<uint32_t>& GetComponentMap() { return m_ComponentToEntityMap; }
+    const SparseIndex& GetEntities() const { return Index(); }
+    Vector<EntityID>& GetComponentMap() { return m_ComponentToEntityMap; }
 
     void SwapMaps(size_t index1, size_t index2) {
+        m_StructureVersion++;
+
         EntityID entityID1 = m_ComponentToEntityMap[index1];
         EntityID entityID2 = m_ComponentToEntityMap[index2];
 
         m_ComponentToEntityMap[index1] = entityID2;
         m_ComponentToEntityMap[index2] = entityID1;
 
-        m_EntityToComponentMap[entityID1] = index2;
-        m_EntityToComponentMap[entityID2] = index1;
+        SetIndex(entityID1, index2);
+        SetIndex(entityID2, index1);
     }
 
     /**
@@ -186,10 +1001,14 @@ public:
      * @return A void pointer to the component data at the specified index.
      */
     void* operator[](size_t index) {
+        ASSERT(IsPacked(), "SoA and shared components have no value in the dense array.");
         return static_cast<uint8_t*>(m_pComponents) + index * m_ComponentSize;
     }
 
 private:
+    // Alignment of the block of an SoA pool
+    static constexpr size_t COLUMN_ALIGNMENT = 64;
+
     /**
      * @brief Allocates memory for the component pool.
      *
@@ -200,24 +1019,72 @@ private:
      * @return `void*` A pointer to the allocated memory.
      */
     void* AllocateComponentPool(size_t componentSize, size_t alignment) {
-        m_PoolSize = INIT_COMPONENT_POOL_SIZE;
-        // TODO: `_aligned_malloc` is not available on all platforms!
-        // return _aligned_malloc(componentSize * m_PoolSize, alignment);
+        m_PoolSize = m_FixedCapacity > 0 ? m_FixedCapacity : INIT_COMPONENT_POOL_SIZE;
+
+        if (IsTag() || IsShared()) {
+            return AllocateStorage(m_PoolSize);
+        }
 
         // Allocate a new component pool with specified alignment
-        return ::operator new(componentSize * m_PoolSize, std::align_val_t(alignment));
+        return m_pResource->allocate(componentSize * m_PoolSize, GetStorageAlignment(alignment));
     }
 
+    /**
+     * @brief Allocates storage for `capacity` components.
+     * Tags have no data, so every tag pool points at the same static byte instead.
+     *
+     * @warning Never call this function directly. It deals with raw memory.
+     */
+    void* AllocateStorage(size_t capacity) {
+        if (IsTag()) {
+            alignas(std::max_align_t) static uint8_t tagStorage[1];
+            return tagStorage;
+        }
+
+        return m_pResource->allocate(SlotSize() * capacity, GetStorageAlignment(m_Alignment));
+    }
+
+    // SoA blocks are cache-line aligned, so columns of cache-line multiples start on one
+    size_t GetStorageAlignment(size_t alignment) const {
+        if (IsShared()) {
+            return alignof(SharedIndex);
+        }
+        return IsSoA() && alignment < COLUMN_ALIGNMENT ? COLUMN_ALIGNMENT : alignment;
+    }
+
+    // Bytes per component in the dense storage
+    size_t SlotSize() const { return IsShared() ? sizeof(SharedIndex) : m_ComponentSize; }
+
+    SharedIndex* SharedSlots() const { return static_cast<SharedIndex*>(m_pComponents); }
+
     /**
      * @brief Deallocates the memory of the component pool.
      *
      * @warning Never call this function directly. It deals with raw memory.
      */
     void DeallocateComponentPool() {
-        // Deallocate the component pool
-        // TODO: THIS IS WIN ONLY!
-        // _aligned_free(m_pComponents);
-        ::operator delete(m_pComponents, std::align_val_t(m_Alignment));
+        // Mapped storage belongs to the file mapping, it is released with it
+        if (m_Mapped) {
+            m_Mapped = false;
+            m_ReadOnly = false;
+            m_pComponents = nullptr;
+            return;
+        }
+
+        if (m_pComponents == nullptr || IsTag()) {
+            m_pComponents = nullptr;
+            return;
+        }
+
+        // Adopted storage was allocated by the caller, outside of the memory resource
+        if (m_Adopted) {
+            ::operator delete(m_pComponents, std::align_val_t(m_Alignment));
+            m_Adopted = false;
+        } else {
+            m_pResource->deallocate(m_pComponents, m_PoolSize * SlotSize(),
+                                    GetStorageAlignment(m_Alignment));
+        }
+        m_pComponents = nullptr;
     }
 
     /**
@@ -231,36 +1098,104 @@ private:
     void* AddComponentToPool(const void* component) {
         // Check if we have space for the new component
         if (m_Count == m_PoolSize) {
-            // If we don't, resize the pool
-            // TODO: As an idea, later we can programmatically mark pools as "hot",
-            // and resize them more aggressively
-            ResizeComponentPool(m_PoolSize * 2);
+            // If we don't, grow the pool as the growth policy says
+            Grow(m_Count + 1);
         }
 
         // Add the component to the pool
-        void* destination = static_cast<uint8_t*>(m_pComponents) + m_Count * m_ComponentSize;
-        memcpy(destination, component, m_ComponentSize);
+        void* destination = WriteComponent(m_Count, component);
         m_Count++;
+        m_AddsThisFrame++;
+        UpdateHighWaterMark();
 
         return destination;
     }
 
     void RemoveComponentFromPool(size_t index) {
-        uint8_t* poolData = static_cast<uint8_t*>(m_pComponents);
-
-        // Remove the component from the pool at `index`
-        void* toRemove = poolData + index * m_ComponentSize;
-        void* lastElement = poolData + (m_Count - 1) * m_ComponentSize;
+        if (IsShared()) {
+            m_SharedValues.Release(SharedSlots()[index]);
+        }
 
         // If the removed element is not the last element, move the last element to the removed element's place
-        if (toRemove != lastElement) {
-            memcpy(toRemove, lastElement, m_ComponentSize);
+        if (index != m_Count - 1) {
+            MoveComponent(index, m_Count - 1);
         }
 
         // Decrement the m_Count
         m_Count--;
 
-        // QUESTION: Should we shrink the pool if the count is less than quarter the capacity to save memory?
+        // Shrinking is up to the shrink policy, once the maps are updated (see `ShrinkIfSparse`)
+    }
+
+    /**
+     * @brief Grows the dense arrays to hold at least `required` components.
+     * How far beyond `required` depends on the growth policy; fixed-capacity pools stop at
+     * their capacity.
+     */
+    void Grow(size_t required) {
+        const GrowthPolicy& policy = m_GrowthPolicy;
+        size_t newSize;
+        if (policy.mode == GrowthPolicy::Mode::FixedStep) {
+            newSize = m_PoolSize + policy.step;
+        } else {
+            newSize = static_cast<size_t>(static_cast<float>(m_PoolSize) * policy.factor);
+
+            // Make room for the next few frames at the observed (or this frame's) rate
+            if (policy.mode == GrowthPolicy::Mode::Adaptive) {
+                float adds = static_cast<float>(m_AddsThisFrame);
+                float rate = adds > m_AddRate ? adds : m_AddRate;
+                size_t ahead = m_Count + static_cast<size_t>(rate * policy.framesAhead);
+                newSize = ahead > newSize ? ahead : newSize;
+            }
+        }
+
+        newSize = newSize > required ? newSize : required;
+        if (m_FixedCapacity > 0 && newSize > m_FixedCapacity) {
+            newSize = m_FixedCapacity;
+        }
+
+        if (ResizeComponentPool(newSize)) {
+            m_ComponentToEntityMap.reserve(newSize);
+        }
+    }
+
+    /**
+     * @brief Applies the shrink policy after a removal.
+     * The pool only shrinks when its occupancy falls below the policy threshold, and only to
+     * the target occupancy, so shrinking stays amortized O(1) per removal.
+     */
+    void ShrinkIfSparse() {
+        const ShrinkPolicy& policy = m_ShrinkPolicy;
+        if (!policy.automatic || m_FixedCapacity > 0 || m_Mapped ||
+            m_PoolSize <= policy.minCapacity ||
+            static_cast<float>(m_Count) >= static_cast<float>(m_PoolSize) * policy.threshold) {
+            return;
+        }
+
+        size_t newSize = static_cast<size_t>(static_cast<float>(m_Count) / policy.target) + 1;
+        Shrink(newSize > policy.minCapacity ? newSize : policy.minCapacity);
+    }
+
+    /**
+     * @brief Reallocates the dense arrays to `capacity` (if smaller) and frees empty index pages.
+     */
+    void Shrink(size_t capacity) {
+        // Fixed pools keep their memory for good
+        if (m_FixedCapacity > 0) {
+            return;
+        }
+
+        // Mapped data is backed by the file, not by the pool
+        if (!m_Mapped && capacity < m_PoolSize) {
+            ResizeComponentPool(capacity);
+
+            Vector<EntityID> entities(m_ComponentToEntityMap.get_allocator());
+            entities.reserve(capacity);
+            entities.assign(m_ComponentToEntityMap.begin(), m_ComponentToEntityMap.end());
+            m_ComponentToEntityMap = std::move(entities);
+        }
+
+        m_EntityToComponentMap.Shrink();
     }
 
     /**
@@ -269,15 +1204,23 @@ private:
      * @warning Never call this function directly. It deals with raw memory.
      *
      * @param newSize The new size of the component pool.
+     * @return `false` if the pool is fixed-capacity and `newSize` exceeds its capacity.
+     * The pool is left untouched then.
      */
-    void ResizeComponentPool(size_t newSize) {
-        void* newComponents =
-            ::operator new(m_ComponentSize * newSize, std::align_val_t(m_Alignment));
+    bool ResizeComponentPool(size_t newSize) {
+        if (m_FixedCapacity > 0 && newSize > m_FixedCapacity) {
+            return false;
+        }
+
+        MECS_TRACE_SCOPE("ComponentPool::Resize");
+
+        void* newComponents = AllocateStorage(newSize);
 
         // Copy the old components to the new pool
-        memcpy(newComponents, m_pComponents, m_ComponentSize * m_Count);
+        CopyStorage(newComponents, newSize);
 
         // Deallocate the old pool
+        // (a mapped pool is promoted to owned memory here)
         DeallocateComponentPool();
 
         // Set the new pool
@@ -285,6 +1228,52 @@ private:
 
         // Set the new capacity
         m_PoolSize = newSize;
+        m_ResizeCount++;
+        return true;
+    }
+
+    // The entity index: the pool's own, or the one of the pool it shares the index of
+    const SparseIndex& Index() const {
+        return m_pIndexOwner != nullptr ? m_pIndexOwner->m_EntityToComponentMap
+                                        : m_EntityToComponentMap;
+    }
+
+    // A pool that shares an index leaves its upkeep to the owner
+    void SetIndex(EntityID entityID, size_t index) {
+        if (m_pIndexOwner == nullptr) {
+            m_EntityToComponentMap.Set(entityID, index);
+        }
+    }
+
+    void EraseIndex(EntityID entityID) {
+        if (m_pIndexOwner == nullptr) {
+            m_EntityToComponentMap.Erase(entityID);
+        }
+    }
+
+    /**
+     * @brief Allocates the index pages holding `count` entities.
+     */
+    void ReserveIndex(const EntityID* entityIDs, size_t count) {
+        if (m_pIndexOwner == nullptr) {
+            m_EntityToComponentMap.ReserveFor(entityIDs, count);
+        }
+    }
+
+    /**
+     * @brief Gives a fixed-capacity shared pool room for a distinct value per component, plus
+     * the one a patch acquires before it releases the old value.
+     */
+    void ReserveSharedValues() {
+        if (IsShared() && IsFixedCapacity()) {
+            m_SharedValues.Reserve(m_FixedCapacity + 1);
+        }
+    }
+
+    void UpdateHighWaterMark() {
+        if (m_Count > m_HighWaterMark) {
+            m_HighWaterMark = m_Count;
+        }
     }
 
     /**
@@ -297,28 +1286,170 @@ private:
      * @return A pointer to the previous component data.
      */
     void* OverwriteComponentData(size_t index, const void* component) {
+        // The previous value is released once the new one is referenced, so it survives if
+        // both are the same
+        if (IsShared()) {
+            SharedIndex previous = SharedSlots()[index];
+            void* destination = WriteComponent(index, component);
+            m_SharedValues.Release(previous);
+            return destination;
+        }
+
         // Overwrite the component in the pool at `index`
-        void* destination = static_cast<uint8_t*>(m_pComponents) + index * m_ComponentSize;
-        memcpy(destination, component, m_ComponentSize);
+        return WriteComponent(index, component);
+    }
 
-        return destination;
+    /**
+     * @brief Returns the start of the column of a field of an SoA pool.
+     */
+    uint8_t* ColumnData(size_t field) const {
+        return static_cast<uint8_t*>(m_pComponents) + m_PoolSize * m_Fields[field].column;
+    }
+
+    /**
+     * @brief Copies a packed component into the slot at `index`.
+     * A shared pool references the value instead, the slot must not hold a reference yet.
+     * @return The component, its first field for SoA pools, or the shared value.
+     */
+    void* WriteComponent(size_t index, const void* component) {
+        if (IsShared()) {
+            SharedSlots()[index] = m_SharedValues.Acquire(component);
+            return const_cast<void*>(m_SharedValues.Get(SharedSlots()[index]));
+        }
+        if (!IsSoA()) {
+            void* destination = static_cast<uint8_t*>(m_pComponents) + index * m_ComponentSize;
+            memcpy(destination, component, m_ComponentSize);
+            return destination;
+        }
+
+        const uint8_t* source = static_cast<const uint8_t*>(component);
+        for (size_t f = 0; f < m_Fields.size(); f++) {
+            const FieldLayout& field = m_Fields[f];
+            memcpy(ColumnData(f) + index * field.size, source + field.offset, field.size);
+        }
+        return ColumnData(0) + index * m_Fields[0].size;
+    }
+
+    /**
+     * @brief Copies `count` packed components into the first slots, replacing the whole
+     * content of the pool. A shared pool deduplicates them into fresh values.
+     */
+    void WritePacked(const void* data, size_t count) {
+        m_SharedValues.Clear();
+        if (count == 0 || IsTag()) {
+            return;
+        }
+        if (IsPacked()) {
+            memcpy(m_pComponents, data, count * m_ComponentSize);
+            return;
+        }
+
+        const uint8_t* source = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < count; i++) { WriteComponent(i, source + i * m_ComponentSize); }
+    }
+
+    void MoveComponent(size_t to, size_t from) {
+        if (!IsSoA()) {
+            uint8_t* data = static_cast<uint8_t*>(m_pComponents);
+            memcpy(data + to * SlotSize(), data + from * SlotSize(), SlotSize());
+            return;
+        }
+
+        for (size_t f = 0; f < m_Fields.size(); f++) {
+            size_t size = m_Fields[f].size;
+            memcpy(ColumnData(f) + to * size, ColumnData(f) + from * size, size);
+        }
+    }
+
+    /**
+     * @brief Copies the live components into `destination`, a block for `capacity` components.
+     * SoA columns move to where they start in a block of that capacity.
+     */
+    void CopyStorage(void* destination, size_t capacity) const {
+        if (!IsSoA()) {
+            memcpy(destination, m_pComponents, SlotSize() * m_Count);
+            return;
+        }
+
+        for (size_t f = 0; f < m_Fields.size(); f++) {
+            const FieldLayout& field = m_Fields[f];
+            memcpy(static_cast<uint8_t*>(destination) + capacity * field.column, ColumnData(f),
+                   m_Count * field.size);
+        }
+    }
+
+    /**
+     * @brief Fills `count` slots of `size` bytes at `destination` with copies of `value`:
+     * one copy, then the filled range keeps doubling.
+     */
+    static void Fill(uint8_t* destination, const void* value, size_t size, size_t count) {
+        memcpy(destination, value, size);
+        for (size_t filled = 1; filled < count;) {
+            size_t chunk = filled < count - filled ? filled : count - filled;
+            memcpy(destination + filled * size, destination, chunk * size);
+            filled += chunk;
+        }
     }
 
 private:
+    // Where all memory of the pool comes from
+    std::pmr::memory_resource* m_pResource;
+
     // Component Pool Info
     void* m_pComponents;
     size_t m_ComponentSize;
     size_t m_Count;
     size_t m_PoolSize;
     size_t m_Alignment;
-    std::string m_Name;
+    String m_Name;
 
     // Maps
-    std::unordered_map<EntityID, size_t> m_EntityToComponentMap;
-    std::vector<uint32_t> m_ComponentToEntityMap;
+    SparseIndex m_EntityToComponentMap;
+    Vector<EntityID> m_ComponentToEntityMap;
 
     // Dirty flag for sorting performance help
     bool m_Sorted = false;
+
+    // Storage points into a file mapping (see `MapComponents`)
+    bool m_Mapped = false;
+    bool m_ReadOnly = false;
+
+    // Storage was handed over with `Ownership::Adopt`
+    bool m_Adopted = false;
+
+    // Change tracking (see `GetVersion` and `GetStructureVersion`)
+    uint64_t m_Version = 0;
+    uint64_t m_StructureVersion = 0;
+
+    // Statistics (see `GetStats`)
+    size_t m_HighWaterMark = 0;
+    size_t m_ResizeCount = 0;
+
+    // Hard limit set by `MakeFixed`, 0 if the pool can grow
+    size_t m_FixedCapacity = 0;
+
+    ShrinkPolicy m_ShrinkPolicy;
+    GrowthPolicy m_GrowthPolicy;
+
+    // Adds since the last `EndFrame`, and the smoothed adds per frame before that
+    size_t m_AddsThisFrame = 0;
+    float m_AddRate = 0.0f;
+
+    // The columns of an SoA pool, empty for packed storage (see `SetFieldLayout`)
+    Vector<FieldLayout> m_Fields;
+
+    // The distinct values of a shared pool (see `MakeShared`), empty otherwise
+    bool m_Shared = false;
+    SharedValueStore m_SharedValues;
+
+    // The pool whose entity index this pool uses, see `ShareIndex`
+    const BasicComponentPool* m_pIndexOwner = nullptr;
+
+#if defined(MECS_ENABLE_PROFILE)
+    mutable PoolAccessCounters m_Access;
+#endif
 };
 
+using ComponentPool = BasicComponentPool<DefaultIDTraits>;
+
 } // namespace microECS
\ No newline at end of file
@@ -4,12 +4,23 @@
 #include "Type.h"
 #include "Types.h"
 
+#include <type_traits>
+#include <utility>
+
 namespace microECS
 {
-    class Entity
+    /**
+     * @brief A handle to an entity of a World with the ID types `Traits`, see `IDTraits`.
+     */
+    template <typename Traits>
+    class BasicEntity
     {
     public:
-        Entity(EntityID id, Registry* registry)
+        using EntityID = typename Traits::EntityID;
+        using ComponentID = typename Traits::ComponentID;
+        using Registry = BasicRegistry<Traits>;
+
+        BasicEntity(EntityID id, Registry* registry)
             : m_ID(id),
               m_pRegistry(registry)
         {
@@ -21,9 +32,9 @@ namespace microECS
         }
 
         template <typename T>
-        Entity& Add()
+        BasicEntity& Add()
         {
-            ComponentID componentID = m_pRegistry->GetComponentID<T>();
+            ComponentID componentID = m_pRegistry->template GetComponentID<T>();
 
             T defaultValue{};
             m_pRegistry->AddComponent(m_ID, componentID, &defaultValue);
@@ -31,9 +42,9 @@ namespace microECS
         }
 
         template <typename T>
-        Entity& Set(const T& value)
+        BasicEntity& Set(const T& value)
         {
-            ComponentID componentID = m_pRegistry->GetComponentID<T>();
+            ComponentID componentID = m_pRegistry->template GetComponentID<T>();
 
             m_pRegistry->SetComponent(m_ID, componentID, &value);
             return *this;
@@ -43,31 +54,42 @@ namespace microECS
         bool Has() const
         {
             // Use a fold expression with logical AND (&&) and expansion pack to check all components
-            return (... && m_pRegistry->HasComponent(m_ID, m_pRegistry->GetComponentID<T>()));
+            return (... && m_pRegistry->HasComponent(
+                               m_ID, m_pRegistry->template GetComponentID<T>()));
         }
 
         template <typename T>
         const T* Get() const
         {
-            ComponentID componentID = m_pRegistry->GetComponentID<T>();
+            static_assert(!IS_SOA<T>, "SoA components have no contiguous value, use a View.");
+            ComponentID componentID = m_pRegistry->template GetComponentID<T>();
 
             const void* component = m_pRegistry->GetComponent(m_ID, componentID);
             return static_cast<const T*>(component);
         }
 
+        // Shared values cannot be written in place, so they are always returned read-only
         template <typename T>
-        T* Get()
+        std::conditional_t<IS_SHARED<T>, const T*, T*> Get()
         {
-            ComponentID componentID = m_pRegistry->GetComponentID<T>();
-
-            void* component = m_pRegistry->GetMutComponent(m_ID, componentID);
-            return static_cast<T*>(component);
+            static_assert(!IS_SOA<T>, "SoA components have no contiguous value, use a View.");
+            if constexpr (IS_SHARED<T>)
+            {
+                return std::as_const(*this).template Get<T>();
+            }
+            else
+            {
+                ComponentID componentID = m_pRegistry->template GetComponentID<T>();
+
+                void* component = m_pRegistry->GetMutComponent(m_ID, componentID);
+                return static_cast<T*>(component);
+            }
         }
 
         template <typename T>
-        Entity& Remove()
+        BasicEntity& Remove()
         {
-            ComponentID componentID = m_pRegistry->GetComponentID<T>();
+            ComponentID componentID = m_pRegistry->template GetComponentID<T>();
 
             m_pRegistry->RemoveComponent(m_ID, componentID);
             return *this;
@@ -88,4 +110,6 @@ namespace microECS
         EntityID m_ID;
         Registry* m_pRegistry;
     };
+
+    using Entity = BasicEntity<DefaultIDTraits>;
 }
\ No newline at end of file
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace microECS {
+
+/**
+ * @brief How a file is mapped into memory.
+ *
+ * `ReadOnly` shares the pages with the page cache and any write is a fault,
+ * `CopyOnWrite` (`MAP_PRIVATE`) gives the process its own copy of a page on first write.
+ * Neither mode ever writes back to the file.
+ */
+enum class MapMode : uint8_t { ReadOnly, CopyOnWrite };
+
+/**
+ * @class FileMapping
+ * @brief A small RAII wrapper around a whole-file memory mapping.
+ *
+ * The mapping base is always page-aligned, so any page-aligned offset inside the file
+ * is page-aligned in memory as well. Pages are faulted in lazily by the OS.
+ */
+class FileMapping {
+public:
+    FileMapping() = default;
+    FileMapping(const FileMapping&) = delete;
+    FileMapping& operator=(const FileMapping&) = delete;
+
+    ~FileMapping() { Close(); }
+
+    /**
+     * @brief Maps the whole file at `path`.
+     *
+     * @param path The path of the file to map.
+     * @param mode Read-only or copy-on-write mapping.
+     * @return `true` on success, `false` if the file could not be opened or mapped.
+     */
+    bool Open(const std::string& path, MapMode mode) {
+        Close();
+        m_Mode = mode;
+
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+            CloseHandle(file);
+            return false;
+        }
+
+        DWORD protect = mode == MapMode::ReadOnly ? PAGE_READONLY : PAGE_WRITECOPY;
+        HANDLE mapping = CreateFileMappingA(file, nullptr, protect, 0, 0, nullptr);
+        CloseHandle(file);
+        if (mapping == nullptr) {
+            return false;
+        }
+
+        DWORD access = mode == MapMode::ReadOnly ? FILE_MAP_READ : FILE_MAP_COPY;
+        m_pData = MapViewOfFile(mapping, access, 0, 0, 0);
+        CloseHandle(mapping);
+        if (m_pData == nullptr) {
+            return false;
+        }
+
+        m_Size = static_cast<size_t>(size.QuadPart);
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+
+        int protect = mode == MapMode::ReadOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+        void* data = ::mmap(nullptr, static_cast<size_t>(st.st_size), protect, MAP_PRIVATE, fd, 0);
+        // The mapping keeps its own reference to the file
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            return false;
+        }
+
+        m_pData = data;
+        m_Size = static_cast<size_t>(st.st_size);
+#endif
+        return true;
+    }
+
+    /**
+     * @brief Unmaps the file. Any pointer into the mapping is invalid afterwards.
+     */
+    void Close() {
+        if (m_pData == nullptr) {
+            return;
+        }
+
+#if defined(_WIN32)
+        UnmapViewOfFile(m_pData);
+#else
+        ::munmap(m_pData, m_Size);
+#endif
+        m_pData = nullptr;
+        m_Size = 0;
+    }
+
+    void* Data() const { return m_pData; }
+    size_t Size() const { return m_Size; }
+    MapMode Mode() const { return m_Mode; }
+    bool IsOpen() const { return m_pData != nullptr; }
+
+private:
+    void* m_pData = nullptr;
+    size_t m_Size = 0;
+    MapMode m_Mode = MapMode::ReadOnly;
+};
+
+} // namespace microECS
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace microECS {
+
+/**
+ * @class Allocator
+ * @brief An STL allocator that takes its memory from a `std::pmr::memory_resource`.
+ *
+ * Unlike `std::pmr::polymorphic_allocator`, it travels with the container on copy, move
+ * and swap. That way every container of a World keeps allocating from the World's resource
+ * after the World is moved, assigned or forked.
+ *
+ * @tparam T The element type.
+ */
+template <typename T>
+class Allocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    Allocator() noexcept : m_pResource(std::pmr::get_default_resource()) {}
+    Allocator(std::pmr::memory_resource* resource) noexcept : m_pResource(resource) {}
+
+    template <typename U>
+    Allocator(const Allocator<U>& other) noexcept : m_pResource(other.GetResource()) {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(m_pResource->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* pointer, size_t count) {
+        m_pResource->deallocate(pointer, count * sizeof(T), alignof(T));
+    }
+
+    // Copies of a container keep allocating from the same resource
+    Allocator select_on_container_copy_construction() const { return *this; }
+
+    std::pmr::memory_resource* GetResource() const { return m_pResource; }
+
+    template <typename U>
+    bool operator==(const Allocator<U>& other) const {
+        return *m_pResource == *other.GetResource();
+    }
+
+    template <typename U>
+    bool operator!=(const Allocator<U>& other) const {
+        return !(*this == other);
+    }
+
+private:
+    std::pmr::memory_resource* m_pResource;
+};
+
+template <typename T>
+using Vector = std::vector<T, Allocator<T>>;
+
+template <typename T>
+using Deque = std::deque<T, Allocator<T>>;
+
+using String = std::basic_string<char, std::char_traits<char>, Allocator<char>>;
+
+struct StringHash {
+    size_t operator()(const String& string) const {
+        return std::hash<std::string_view>()(std::string_view(string.data(), string.size()));
+    }
+};
+
+template <typename K, typename V, typename Hash = std::hash<K>>
+using HashMap = std::unordered_map<K, V, Hash, std::equal_to<K>, Allocator<std::pair<const K, V>>>;
+
+/**
+ * @class CountingResource
+ * @brief A memory resource that forwards to another one and counts what goes through it.
+ *
+ * Pass it to a World to attribute memory to that World, or reset the counters at the start
+ * of a frame and read them at the end to count the allocations made during the frame.
+ *
+ * @code
+ * microECS::CountingResource memory;
+ * microECS::World world(&memory);
+ * ...
+ * memory.ResetCounters();
+ * RunFrame(world);
+ * printf("%zu allocations\n", memory.GetAllocationCount());
+ * @endcode
+ *
+ * @note Not thread-safe, like the World using it.
+ */
+class CountingResource : public std::pmr::memory_resource {
+public:
+    explicit CountingResource(
+        std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : m_pUpstream(upstream) {}
+
+    CountingResource(const CountingResource&) = delete;
+    CountingResource& operator=(const CountingResource&) = delete;
+
+    /**
+     * @brief Returns the number of allocations since construction or `ResetCounters`.
+     */
+    size_t GetAllocationCount() const { return m_AllocationCount; }
+
+    /**
+     * @brief Returns the number of deallocations since construction or `ResetCounters`.
+     */
+    size_t GetDeallocationCount() const { return m_DeallocationCount; }
+
+    /**
+     * @brief Returns the number of bytes allocated since construction or `ResetCounters`.
+     */
+    size_t GetAllocatedBytes() const { return m_AllocatedBytes; }
+
+    /**
+     * @brief Returns the number of bytes currently allocated and not yet freed.
+     */
+    size_t GetBytesInUse() const { return m_BytesInUse; }
+
+    /**
+     * @brief Returns the largest `GetBytesInUse` since construction or `ResetCounters`.
+     */
+    size_t GetPeakBytes() const { return m_PeakBytes; }
+
+    /**
+     * @brief Starts a new counting period. Bytes in use are kept, since that memory is still live.
+     */
+    void ResetCounters() {
+        m_AllocationCount = 0;
+        m_DeallocationCount = 0;
+        m_AllocatedBytes = 0;
+        m_PeakBytes = m_BytesInUse;
+    }
+
+    std::pmr::memory_resource* GetUpstream() const { return m_pUpstream; }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* pointer = m_pUpstream->allocate(bytes, alignment);
+        m_AllocationCount++;
+        m_AllocatedBytes += bytes;
+        m_BytesInUse += bytes;
+        if (m_BytesInUse > m_PeakBytes) {
+            m_PeakBytes = m_BytesInUse;
+        }
+
+        return pointer;
+    }
+
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override {
+        m_pUpstream->deallocate(pointer, bytes, alignment);
+        m_DeallocationCount++;
+        m_BytesInUse -= bytes;
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    std::pmr::memory_resource* m_pUpstream;
+    size_t m_AllocationCount = 0;
+    size_t m_DeallocationCount = 0;
+    size_t m_AllocatedBytes = 0;
+    size_t m_BytesInUse = 0;
+    size_t m_PeakBytes = 0;
+};
+
+/**
+ * @class SlabResource
+ * @brief A memory resource that hands out memory from one slab allocated up front.
+ *
+ * Allocation is a pointer bump and deallocation does nothing; memory is only given back
+ * when the resource is destroyed. When the slab is used up, allocation throws
+ * `std::bad_alloc` instead of falling back to another allocator.
+ * Used by fixed-capacity Worlds, see `WorldCapacity`.
+ */
+class SlabResource : public std::pmr::memory_resource {
+public:
+    /**
+     * @param bytes The size of the slab.
+     * @param upstream The resource the slab itself is allocated from, once.
+     */
+    SlabResource(size_t bytes, std::pmr::memory_resource* upstream)
+        : m_pUpstream(upstream), m_pSlab(upstream->allocate(bytes, alignof(std::max_align_t))),
+          m_Size(bytes), m_Arena(m_pSlab, bytes, std::pmr::null_memory_resource()) {}
+
+    SlabResource(const SlabResource&) = delete;
+    SlabResource& operator=(const SlabResource&) = delete;
+
+    ~SlabResource() {
+        m_Arena.release();
+        m_pUpstream->deallocate(m_pSlab, m_Size, alignof(std::max_align_t));
+    }
+
+    /**
+     * @brief Returns the size of the slab.
+     */
+    size_t GetSize() const { return m_Size; }
+
+    /**
+     * @brief Returns the number of bytes handed out so far, alignment padding excluded.
+     */
+    size_t GetUsedBytes() const { return m_UsedBytes; }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* pointer = m_Arena.allocate(bytes, alignment);
+        m_UsedBytes += bytes;
+        return pointer;
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    std::pmr::memory_resource* m_pUpstream;
+    void* m_pSlab;
+    size_t m_Size;
+    size_t m_UsedBytes = 0;
+    std::pmr::monotonic_buffer_resource m_Arena;
+};
+
+} // namespace microECS
@@ -0,0 +1,307 @@
+#pragma once
+
+#include "Assert.h"
+#include "Memory.h"
+#include "Types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <string_view>
+
+namespace microECS {
+
+/**
+ * @brief FNV-1a hash of an entity name. `constexpr`, so names known at compile time can be
+ * hashed by the compiler (see `HashedName`).
+ */
+constexpr uint64_t HashName(const char* data, size_t length) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+/**
+ * @brief An entity name together with its hash, for lookups that skip hashing at runtime.
+ * Create one with the `_name` literal and keep it `constexpr`:
+ *
+ * @code
+ * using namespace microECS::literals;
+ * constexpr microECS::HashedName PLAYER = "Player"_name;
+ * world.Lookup(PLAYER);
+ * @endcode
+ */
+struct HashedName {
+    std::string_view name;
+    uint64_t hash;
+
+    constexpr HashedName(const char* data, size_t length)
+        : name(data, length), hash(HashName(data, length)) {}
+};
+
+namespace literals {
+constexpr HashedName operator""_name(const char* data, size_t length) {
+    return HashedName(data, length);
+}
+} // namespace literals
+
+/**
+ * @class BasicNameIndex
+ * @brief A bidirectional map between entities and their names.
+ *
+ * Names are interned: each distinct name is stored once in a character arena and referred to
+ * by a handle. A dense array indexed by entity index gives the name of an entity with one load,
+ * and an open-addressing hash table of handles finds the entity of a name.
+ * Interned names stay in the arena after their entity is destroyed, so naming an entity with
+ * a name that was used before does not allocate. The arena is compacted once most of it is
+ * unused.
+ */
+template <typename Traits>
+class BasicNameIndex {
+public:
+    using EntityID = typename Traits::EntityID;
+
+    static constexpr EntityID INVALID_ENTITY_ID = Traits::INVALID_ENTITY_ID;
+
+    explicit BasicNameIndex(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : m_Strings(resource), m_Entries(resource), m_Table(resource), m_EntityNames(resource) {}
+
+    /**
+     * @brief Returns the entity with the given name, or `INVALID_ENTITY_ID`.
+     */
+    EntityID Find(std::string_view name) const {
+        return Find(HashedName(name.data(), name.size()));
+    }
+
+    EntityID Find(const HashedName& name) const {
+        uint32_t handle = FindHandle(name.name, name.hash);
+        return handle != INVALID_HANDLE ? m_Entries[handle].entityID : INVALID_ENTITY_ID;
+    }
+
+    /**
+     * @brief Returns the name of an entity, or an empty view if it has none.
+     * The view is invalidated by the next change to the index.
+     */
+    std::string_view GetName(EntityID entityID) const {
+        uint32_t handle = GetHandle(entityID);
+        if (handle == INVALID_HANDLE) {
+            return {};
+        }
+
+        const Entry& entry = m_Entries[handle];
+        return std::string_view(m_Strings.data() + entry.offset, entry.length);
+    }
+
+    /**
+     * @brief Names an entity. A previous name of the entity is dropped, and if another
+     * entity had this name, it loses it.
+     */
+    void Insert(EntityID entityID, std::string_view name) {
+        ASSERT(entityID != INVALID_ENTITY_ID, "Invalid entity ID.");
+        Erase(entityID);
+
+        uint32_t handle = Intern(name);
+        Entry& entry = m_Entries[handle];
+        if (entry.entityID != INVALID_ENTITY_ID) {
+            m_EntityNames[Traits::GetIndex(entry.entityID)] = INVALID_HANDLE;
+        } else {
+            m_Count++;
+            m_UsedBytes += entry.length;
+        }
+        entry.entityID = entityID;
+
+        size_t index = Traits::GetIndex(entityID);
+        if (index >= m_EntityNames.size()) {
+            m_EntityNames.resize(index + 1, INVALID_HANDLE);
+        }
+        m_EntityNames[index] = handle;
+    }
+
+    /**
+     * @brief Removes the name of an entity, if it has one. The name stays interned.
+     */
+    void Erase(EntityID entityID) {
+        uint32_t handle = GetHandle(entityID);
+        if (handle == INVALID_HANDLE) {
+            return;
+        }
+
+        Entry& entry = m_Entries[handle];
+        entry.entityID = INVALID_ENTITY_ID;
+        m_EntityNames[Traits::GetIndex(entityID)] = INVALID_HANDLE;
+        m_Count--;
+        m_UsedBytes -= entry.length;
+
+        // Drop unused names once they take up most of the arena
+        if (m_Strings.size() > MIN_COMPACT_BYTES && m_UsedBytes * 4 < m_Strings.size()) {
+            Compact();
+        }
+    }
+
+    /**
+     * @brief Removes every name.
+     */
+    void Clear() {
+        m_Strings.clear();
+        m_Entries.clear();
+        m_Table.clear();
+        m_EntityNames.clear();
+        m_Count = 0;
+        m_UsedBytes = 0;
+    }
+
+    /**
+     * @brief Calls `func(EntityID, std::string_view)` for every named entity.
+     */
+    template <typename Func>
+    void ForEach(Func func) const {
+        for (const Entry& entry : m_Entries) {
+            if (entry.entityID != INVALID_ENTITY_ID) {
+                func(entry.entityID, std::string_view(m_Strings.data() + entry.offset,
+                                                      entry.length));
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the number of named entities.
+     */
+    size_t GetCount() const { return m_Count; }
+
+    /**
+     * @brief Returns the number of bytes allocated by the index.
+     */
+    size_t GetMemoryUsage() const {
+        return m_Strings.capacity() + m_Entries.capacity() * sizeof(Entry) +
+               m_Table.capacity() * sizeof(uint32_t) + m_EntityNames.capacity() * sizeof(uint32_t);
+    }
+
+private:
+    static constexpr uint32_t INVALID_HANDLE = UINT32_MAX;
+    static constexpr size_t MIN_TABLE_SIZE = 64;
+    static constexpr size_t MIN_COMPACT_BYTES = 4096;
+
+    struct Entry {
+        uint64_t hash;
+        uint32_t offset; // Into `m_Strings`
+        uint32_t length;
+        EntityID entityID; // `INVALID_ENTITY_ID` while the name is unused
+    };
+
+    /**
+     * @brief Returns the handle of the name of an entity, or `INVALID_HANDLE` if it has none.
+     * An older generation of the entity does not get the name of the current one.
+     */
+    uint32_t GetHandle(EntityID entityID) const {
+        size_t index = Traits::GetIndex(entityID);
+        if (index >= m_EntityNames.size() || m_EntityNames[index] == INVALID_HANDLE ||
+            m_Entries[m_EntityNames[index]].entityID != entityID) {
+            return INVALID_HANDLE;
+        }
+
+        return m_EntityNames[index];
+    }
+
+    uint32_t FindHandle(std::string_view name, uint64_t hash) const {
+        if (m_Table.empty()) {
+            return INVALID_HANDLE;
+        }
+
+        size_t mask = m_Table.size() - 1;
+        for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+            uint32_t handle = m_Table[slot];
+            if (handle == INVALID_HANDLE) {
+                return INVALID_HANDLE;
+            }
+
+            const Entry& entry = m_Entries[handle];
+            if (entry.hash == hash && entry.length == name.size() &&
+                memcmp(m_Strings.data() + entry.offset, name.data(), name.size()) == 0) {
+                return handle;
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the handle of a name, adding it to the arena if it is new.
+     */
+    uint32_t Intern(std::string_view name) {
+        uint64_t hash = HashName(name.data(), name.size());
+        uint32_t handle = FindHandle(name, hash);
+        if (handle != INVALID_HANDLE) {
+            return handle;
+        }
+
+        ASSERT(m_Strings.size() + name.size() <= UINT32_MAX, "Too many entity names.");
+        handle = static_cast<uint32_t>(m_Entries.size());
+        m_Entries.push_back({ hash, static_cast<uint32_t>(m_Strings.size()),
+                              static_cast<uint32_t>(name.size()), INVALID_ENTITY_ID });
+        m_Strings.insert(m_Strings.end(), name.begin(), name.end());
+
+        // Keep the table at most half full
+        if (m_Entries.size() * 2 > m_Table.size()) {
+            Rehash(m_Table.size() * 2 > MIN_TABLE_SIZE ? m_Table.size() * 2 : MIN_TABLE_SIZE);
+        } else {
+            InsertHandle(handle);
+        }
+
+        return handle;
+    }
+
+    void InsertHandle(uint32_t handle) {
+        size_t mask = m_Table.size() - 1;
+        size_t slot = m_Entries[handle].hash & mask;
+        while (m_Table[slot] != INVALID_HANDLE) { slot = (slot + 1) & mask; }
+        m_Table[slot] = handle;
+    }
+
+    void Rehash(size_t size) {
+        m_Table.assign(size, INVALID_HANDLE);
+        for (size_t i = 0; i < m_Entries.size(); i++) { InsertHandle(static_cast<uint32_t>(i)); }
+    }
+
+    /**
+     * @brief Rebuilds the arena and the table from the names that are in use.
+     */
+    void Compact() {
+        Vector<char> strings(m_Strings.get_allocator());
+        Vector<Entry> entries(m_Entries.get_allocator());
+        strings.reserve(m_UsedBytes);
+        entries.reserve(m_Count);
+
+        for (const Entry& entry : m_Entries) {
+            if (entry.entityID == INVALID_ENTITY_ID) {
+                continue;
+            }
+
+            m_EntityNames[Traits::GetIndex(entry.entityID)] = static_cast<uint32_t>(entries.size());
+            entries.push_back({ entry.hash, static_cast<uint32_t>(strings.size()), entry.length,
+                                entry.entityID });
+            strings.insert(strings.end(), m_Strings.begin() + entry.offset,
+                           m_Strings.begin() + entry.offset + entry.length);
+        }
+
+        m_Strings = std::move(strings);
+        m_Entries = std::move(entries);
+
+        size_t size = MIN_TABLE_SIZE;
+        while (size < m_Entries.size() * 2) { size *= 2; }
+        Rehash(size);
+    }
+
+private:
+    Vector<char> m_Strings; // The arena of interned names
+    Vector<Entry> m_Entries;
+    Vector<uint32_t> m_Table;       // Open addressing, linear probing, power-of-two size
+    Vector<uint32_t> m_EntityNames; // Entity index -> handle
+    size_t m_Count = 0;
+    size_t m_UsedBytes = 0; // Bytes of the names in use
+};
+
+using NameIndex = BasicNameIndex<DefaultIDTraits>;
+
+} // namespace microECS
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Types.h"
+
+#include <cstddef>
+
+namespace microECS {
+
+/**
+ * @brief How a component pool grows when it runs out of room.
+ *
+ * - `Geometric` multiplies the capacity by `factor` (the default doubles it).
+ * - `FixedStep` adds room for `step` more components, for pools whose size is known to grow
+ *   by a steady amount and where doubling would waste memory.
+ * - `Adaptive` grows geometrically, but at least far enough to hold `framesAhead` frames'
+ *   worth of adds at the rate observed between `World::EndFrame` calls, so a pool that
+ *   receives thousands of components per frame reaches its working size in one resize.
+ */
+struct GrowthPolicy {
+    enum class Mode { Geometric, FixedStep, Adaptive };
+
+    Mode mode = Mode::Geometric;
+    float factor = 2.0f;                    // Geometric and Adaptive: capacity multiplier
+    size_t step = INIT_COMPONENT_POOL_SIZE; // FixedStep: components added per growth
+    float framesAhead = 8.0f;               // Adaptive: frames of adds to make room for
+
+    static GrowthPolicy Geometric(float factor = 2.0f) {
+        GrowthPolicy policy;
+        policy.factor = factor;
+        return policy;
+    }
+
+    static GrowthPolicy FixedStep(size_t step) {
+        GrowthPolicy policy;
+        policy.mode = Mode::FixedStep;
+        policy.step = step;
+        return policy;
+    }
+
+    static GrowthPolicy Adaptive(float framesAhead = 8.0f, float factor = 2.0f) {
+        GrowthPolicy policy;
+        policy.mode = Mode::Adaptive;
+        policy.framesAhead = framesAhead;
+        policy.factor = factor;
+        return policy;
+    }
+};
+
+/**
+ * @brief When a component pool gives memory back after components are removed.
+ *
+ * With `automatic` set, a pool shrinks once its occupancy (count / capacity) drops below
+ * `threshold`, to a capacity at which the occupancy is `target`. Since growth doubles the
+ * capacity at full occupancy, a pool has to lose or gain a large share of its components
+ * between two resizes, so adding and removing around either threshold cannot thrash.
+ * The dense arrays shrink, and pages of the entity index without live entries are freed.
+ */
+struct ShrinkPolicy {
+    bool automatic = false;
+    float threshold = 0.25f;                       // Occupancy that triggers a shrink
+    float target = 0.5f;                           // Occupancy right after a shrink
+    size_t minCapacity = INIT_COMPONENT_POOL_SIZE; // A pool never shrinks below this
+
+    /**
+     * @brief Returns a policy that shrinks automatically with the given thresholds.
+     */
+    static ShrinkPolicy Automatic(float threshold = 0.25f, float target = 0.5f) {
+        ShrinkPolicy policy;
+        policy.automatic = true;
+        policy.threshold = threshold;
+        policy.target = target;
+        return policy;
+    }
+};
+
+/**
+ * @brief Which free entity ID a registry hands out first.
+ *
+ * - `Fifo` reuses the ID that was freed first, so an ID stays unused for as long as possible
+ *   and stale handles in worlds without generations are less likely to alias a new entity.
+ * - `Lifo` reuses the ID that was freed last, whose record and sparse pages are most likely
+ *   still in cache.
+ */
+enum class ReusePolicy { Fifo, Lifo };
+
+} // namespace microECS
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Assert.h"
+#include "Memory.h"
+#include "Registry.h"
+#include "Types.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace microECS {
+
+/**
+ * @class BasicPrefab
+ * @brief A reusable set of component values for instancing many identical entities.
+ *
+ * Components are resolved to their ComponentID and copied into a byte blob when they are set,
+ * so `World::Instantiate` only copies blobs into pools, without any per-entity type lookup.
+ *
+ * @warning A Prefab belongs to the World that created it, since ComponentIDs are per World.
+ */
+template <typename Traits>
+class BasicPrefab {
+public:
+    using ComponentID = typename Traits::ComponentID;
+    using Registry = BasicRegistry<Traits>;
+
+    explicit BasicPrefab(Registry* registry)
+        : m_pRegistry(registry), m_Components(registry->GetMemoryResource()),
+          m_Data(registry->GetMemoryResource()) {}
+
+    /**
+     * @brief Adds a component with its default value to the prefab.
+     *
+     * @tparam T The component type.
+     * @return The prefab, for chaining.
+     */
+    template <typename T>
+    BasicPrefab& Add() {
+        T defaultValue {};
+        return Set<T>(defaultValue);
+    }
+
+    /**
+     * @brief Sets the value of a component in the prefab, adding the component if needed.
+     *
+     * @tparam T The component type.
+     * @param value The value every instance starts with.
+     * @return The prefab, for chaining.
+     */
+    template <typename T>
+    BasicPrefab& Set(const T& value) {
+        ComponentID componentID = m_pRegistry->template GetComponentID<T>();
+
+        for (auto& component : m_Components) {
+            if (component.componentID == componentID) {
+                memcpy(m_Data.data() + component.offset, &value, sizeof(T));
+                return *this;
+            }
+        }
+
+        m_Components.push_back({ componentID, m_Data.size() });
+        m_Data.resize(m_Data.size() + sizeof(T));
+        memcpy(m_Data.data() + m_Components.back().offset, &value, sizeof(T));
+
+        return *this;
+    }
+
+    /**
+     * @brief Removes a component from the prefab.
+     *
+     * @tparam T The component type.
+     * @return The prefab, for chaining.
+     */
+    template <typename T>
+    BasicPrefab& Remove() {
+        ComponentID componentID = m_pRegistry->template GetComponentID<T>();
+
+        for (size_t i = 0; i < m_Components.size(); i++) {
+            if (m_Components[i].componentID == componentID) {
+                m_Components.erase(m_Components.begin() + i);
+                break;
+            }
+        }
+
+        return *this;
+    }
+
+    size_t GetComponentCount() const { return m_Components.size(); }
+    ComponentID GetComponentID(size_t index) const { return m_Components[index].componentID; }
+    const void* GetComponentData(size_t index) const {
+        return m_Data.data() + m_Components[index].offset;
+    }
+    const Registry* GetRegistry() const { return m_pRegistry; }
+
+private:
+    struct Component {
+        ComponentID componentID;
+        size_t offset; // Into m_Data
+    };
+
+    Registry* m_pRegistry;
+    Vector<Component> m_Components;
+    Vector<uint8_t> m_Data;
+};
+
+using Prefab = BasicPrefab<DefaultIDTraits>;
+
+} // namespace microECS
@@ -0,0 +1,148 @@
+#pragma once
+
+/**
+ * @brief Access counters of component pools, for deciding how components should be laid out.
+ *
+ * Define `MECS_ENABLE_PROFILE` (before including microECS) to count the reads, writes and
+ * iterations of every pool, and read them back with `World::AccessReport`. For SoA components
+ * (see `SoAFields`) views also record which fields every pass touches, so the report can flag
+ * large components whose fields are rarely used together, i.e. candidates for splitting into
+ * a hot and a cold part (see `SplitComponent`).
+ * Without `MECS_ENABLE_PROFILE` nothing is counted and the report is empty.
+ *
+ * @note Counters are not synchronized, like the pools they belong to.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(MECS_ENABLE_PROFILE)
+#define MECS_PROFILE(statement) statement
+#else
+#define MECS_PROFILE(statement) ((void)0)
+#endif
+
+namespace microECS {
+
+/**
+ * @brief A set of fields that was touched together, and how many passes touched exactly it.
+ */
+struct FieldGroupStats {
+    uint64_t fields = 0; // Bit `i` is field `i` of the SoA layout
+    uint64_t passes = 0;
+};
+
+/**
+ * @brief The counters of one pool.
+ */
+struct PoolAccessCounters {
+    uint64_t reads = 0;      // Single components read through a const lookup
+    uint64_t writes = 0;     // Components set, patched or handed out mutable one at a time
+    uint64_t iterations = 0; // Components visited by views and field spans
+    uint64_t passes = 0;     // Views and field spans over the pool
+
+    // Per distinct field set, SoA pools only
+    std::vector<FieldGroupStats> fieldGroups;
+
+    /**
+     * @brief Records one pass over `visited` components that touched the fields in `fields`,
+     * or no fields that could be told apart if `fields` is 0.
+     */
+    void RecordPass(size_t visited, uint64_t fields) {
+        passes++;
+        iterations += visited;
+        if (fields == 0) {
+            return;
+        }
+
+        for (FieldGroupStats& group : fieldGroups) {
+            if (group.fields == fields) {
+                group.passes++;
+                return;
+            }
+        }
+        fieldGroups.push_back({ fields, 1 });
+    }
+};
+
+/**
+ * @brief How one pool was used since the counters were last reset.
+ */
+struct PoolAccessStats {
+    std::string name;
+    size_t componentSize = 0;
+    size_t fieldCount = 0; // SoA fields, 0 for packed components
+    PoolAccessCounters counters;
+
+    // Average share of the fields a pass touched, 1 without field information
+    float cohesion = 1.0f;
+
+    // Fields touched by at least half of the passes that touched any field
+    uint64_t hotFields = 0;
+
+    // Large, iterated, and most passes only touch a few of its fields
+    bool splitCandidate = false;
+};
+
+/**
+ * @brief The access counters of every pool, as reported by `World::AccessReport`.
+ */
+struct AccessReport {
+    std::vector<PoolAccessStats> pools;
+
+    /**
+     * @brief Returns the pools that are flagged as split candidates.
+     */
+    std::vector<const PoolAccessStats*> SplitCandidates() const {
+        std::vector<const PoolAccessStats*> candidates;
+        for (const PoolAccessStats& pool : pools) {
+            if (pool.splitCandidate) {
+                candidates.push_back(&pool);
+            }
+        }
+        return candidates;
+    }
+};
+
+/**
+ * @brief Fills in the derived fields of `stats` from its counters.
+ *
+ * @param largeComponentBytes Components at least this large can be flagged.
+ * @param cohesionThreshold Components are flagged if passes touch less than this share of
+ * their fields on average.
+ */
+inline void AnalyzeAccess(PoolAccessStats& stats, size_t largeComponentBytes,
+                          float cohesionThreshold) {
+    uint64_t fieldPasses = 0;
+    uint64_t touched = 0;
+    for (const FieldGroupStats& group : stats.counters.fieldGroups) {
+        fieldPasses += group.passes;
+        for (uint64_t fields = group.fields; fields != 0; fields &= fields - 1) {
+            touched += group.passes;
+        }
+    }
+
+    if (fieldPasses == 0 || stats.fieldCount == 0) {
+        return;
+    }
+
+    stats.cohesion = static_cast<float>(static_cast<double>(touched) /
+                                        static_cast<double>(fieldPasses * stats.fieldCount));
+
+    for (size_t field = 0; field < stats.fieldCount && field < 64; field++) {
+        uint64_t passes = 0;
+        for (const FieldGroupStats& group : stats.counters.fieldGroups) {
+            passes += (group.fields >> field) & 1 ? group.passes : 0;
+        }
+        if (passes * 2 >= fieldPasses) {
+            stats.hotFields |= uint64_t(1) << field;
+        }
+    }
+
+    stats.splitCandidate =
+        stats.componentSize >= largeComponentBytes && stats.cohesion < cohesionThreshold;
+}
+
+} // namespace microECS
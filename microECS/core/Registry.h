@@ -1,11 +1,24 @@
 #pragma once
 
 #include "ComponentPool.h"
+#include "FileMapping.h"
+#include "Memory.h"
+#include "NameIndex.h"
+#include "SingletonStore.h"
+#include "Snapshot.h"
+#include "Split.h"
+#include "Trace.h"
 #include "Types.h"
+#include "WorldImage.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <memory_resource>
 #include <new>
-#include <queue>
 #include <string>
 #include <typeindex>
 #include <unordered_map>
@@ -17,38 +30,307 @@ namespace microECS {
      * @brief The Registry is the underlying brain of the ECS system.
      * It is responsible for internal C-style functions and data structures.
      * Serves as the main hub for creating, adding, and removing entities and components.
+     * Everything it allocates, including the component pools, comes from one memory resource.
+     *
+     * Entities are records in one array indexed by entity index. A live record holds the
+     * entity's ID; the records of destroyed entities form an implicit free list, each one
+     * holding the index of the next free record (see `ReusePolicy`), so creating and
+     * destroying entities never allocates for bookkeeping.
+     *
+     * New indices are handed out by an atomic counter, so other threads can reserve entity IDs
+     * while the main thread uses the registry (see `ReserveEntities`). Everything else must
+     * happen on one thread at a time.
+     *
+     * @tparam Traits The ID types, see `IDTraits`. With generations, destroying an entity
+     * bumps the generation kept in its record, so old handles stop being valid.
      */
-class Registry {
+template <typename Traits>
+class BasicRegistry {
 public:
+    using EntityID = typename Traits::EntityID;
+    using ComponentID = typename Traits::ComponentID;
+    using EntityIndex = typename Traits::EntityIndex;
+    using ComponentPool = BasicComponentPool<Traits>;
+    using NameIndex = BasicNameIndex<Traits>;
+    using ByteRange = BasicByteRange<Traits>;
+    using PoolDelta = BasicPoolDelta<Traits>;
+    using WorldDelta = BasicWorldDelta<Traits>;
+
+    static constexpr EntityID INVALID_ENTITY_ID = Traits::INVALID_ENTITY_ID;
+    static constexpr ComponentID INVALID_COMPONENT_ID = Traits::INVALID_COMPONENT_ID;
+    static constexpr size_t MAX_COMPONENT_TYPES = Traits::MAX_COMPONENT_TYPES;
+
+    BasicRegistry() : BasicRegistry(std::pmr::get_default_resource()) {}
+
     /**
-         * @brief Deconstructor of the Registry.
-         * @attention This is responsible for freeing all the memory allocated for the component pools.
+         * @brief Creates a registry that allocates all of its memory from `resource`.
+         *
+         * @param resource The memory resource. Must outlive the registry and all of its copies.
+         */
+    explicit BasicRegistry(std::pmr::memory_resource* resource)
+        : m_pResource(resource), m_ComponentPools(resource), m_ComponentTypeMap(resource),
+          m_Singletons(resource), m_Names(resource), m_Entities(resource),
+          m_UnboundComponentMap(resource), m_DeadScratch(resource), m_EntityScratch(resource),
+          m_GroupScratch(resource), m_SplitLinks(resource), m_SplitDefaults(resource) {}
+
+    /**
+         * @brief Copies the registry by sharing its component pools with the original.
+         * Pools are copy-on-write: a pool is duplicated the first time either registry
+         * modifies it, so copying is cheap no matter how much component data there is.
+         * Singleton components are small and are copied right away.
+         * The copy allocates from the same memory resource.
          */
-    ~Registry() {
-        // Calling cleanup on the component pools to free any memory that was allocated.
-        for (auto& component : m_ComponentPools) { component.Cleanup(); }
+    BasicRegistry(const BasicRegistry& other)
+        : m_pResource(other.m_pResource), m_pImage(other.m_pImage),
+          m_ComponentPools(other.m_ComponentPools),
+          m_ComponentTypeMap(other.m_ComponentTypeMap), m_Singletons(other.m_Singletons),
+          m_Names(other.m_Names), m_Entities(other.m_Entities), m_FreeHead(other.m_FreeHead),
+          m_FreeTail(other.m_FreeTail), m_FreeCount(other.m_FreeCount),
+          m_ReusePolicy(other.m_ReusePolicy), m_NextEntityID(other.m_NextEntityID),
+          m_ReservedEntityID(other.m_ReservedEntityID.load(std::memory_order_relaxed)),
+          m_MaxEntities(other.m_MaxEntities), m_PoolCapacity(other.m_PoolCapacity),
+          m_UnboundComponentMap(other.m_UnboundComponentMap), m_DeadScratch(other.m_pResource),
+          m_EntityScratch(other.m_pResource), m_GroupScratch(other.m_pResource),
+          m_ShrinkPolicy(other.m_ShrinkPolicy),
+          m_GrowthPolicy(other.m_GrowthPolicy), m_SplitLinks(other.m_SplitLinks),
+          m_SplitDefaults(other.m_SplitDefaults) {
+        m_DeadScratch.reserve(other.m_DeadScratch.capacity());
+        m_EntityScratch.reserve(other.m_EntityScratch.capacity());
+        m_GroupScratch.keys.reserve(other.m_GroupScratch.keys.capacity());
+        m_GroupScratch.ends.reserve(other.m_GroupScratch.ends.capacity());
+        m_GroupScratch.entities.reserve(other.m_GroupScratch.entities.capacity());
     }
+
+    BasicRegistry(BasicRegistry&& other) noexcept { Swap(other); }
+
+    BasicRegistry& operator=(BasicRegistry other) noexcept {
+        Swap(other);
+        return *this;
+    }
+
+    /**
+         * @brief Deconstructor of the Registry.
+         * @attention Component pools free themselves once no copy of the registry uses them.
+         * Singleton components are freed with the singleton store.
+         */
+    ~BasicRegistry() = default;
+
     /**
          * @brief Creates a new entity.
          * As this is an internal function, it only fetches the next available entity ID.
          * It is not meant to be called directly.
          *
          * @overload CreateEntity(const std::string& name)
-         * @return The ID of the newly created entity.
+         * @return The ID of the newly created entity, or `INVALID_ENTITY_ID` if a
+         * fixed-capacity registry is full.
          */
     EntityID CreateEntity() {
         EntityID id;
 
-        if (!m_FreeEntityIDs.empty()) {
-            id = m_FreeEntityIDs.front();
-            m_FreeEntityIDs.pop();
+        if (m_FreeCount > 0) {
+            id = PopFreeEntity();
         } else {
-            id = m_NextEntityID++;
+            id = ReserveEntities(1);
+            FlushReservedEntities();
         }
 
         return id;
     }
 
+    /**
+         * @brief Creates `count` new entities at once.
+         * Free IDs are reused first, the rest is reserved with a single counter bump.
+         * The new IDs are written in that order.
+         *
+         * @param count The number of entities to create.
+         * @param out Receives the `count` new entity IDs.
+         * @return `false` if a fixed-capacity registry has no room for `count` more entities.
+         * No entity is created then.
+         */
+    bool CreateEntities(size_t count, EntityID* out) {
+        size_t reused = count < m_FreeCount ? count : m_FreeCount;
+        EntityID first = INVALID_ENTITY_ID;
+        if (count > reused) {
+            first = ReserveEntities(count - reused);
+            if (first == INVALID_ENTITY_ID) {
+                return false;
+            }
+            FlushReservedEntities();
+        }
+
+        size_t i = 0;
+        for (; i < reused; i++) { out[i] = PopFreeEntity(); }
+        for (EntityID index = first; i < count; i++, index++) { out[i] = m_Entities[index]; }
+        return true;
+    }
+
+    /**
+         * @brief Reserves `count` consecutive entity IDs without creating the entities yet.
+         * Only touches an atomic counter, so any thread may call it, also while the main thread
+         * uses the registry. The entities exist from the next `FlushReservedEntities` on; until
+         * then they are not valid.
+         * Reserved IDs are always new indices with generation 0, free IDs are only reused by
+         * `CreateEntity`.
+         *
+         * @param count The number of IDs to reserve.
+         * @return The first of the `count` IDs, or `INVALID_ENTITY_ID` if there is no room
+         * for them.
+         */
+    EntityID ReserveEntities(size_t count) {
+        EntityID first = m_ReservedEntityID.load(std::memory_order_relaxed);
+        do {
+            if (count > static_cast<size_t>(m_MaxEntities - first)) {
+                return INVALID_ENTITY_ID;
+            }
+        } while (!m_ReservedEntityID.compare_exchange_weak(
+            first, static_cast<EntityID>(first + count), std::memory_order_relaxed));
+
+        return first;
+    }
+
+    /**
+         * @brief Turns every ID reserved so far into an entity without components.
+         * Main thread only.
+         */
+    void FlushReservedEntities() {
+        EntityID reserved = m_ReservedEntityID.load(std::memory_order_relaxed);
+        if (reserved > m_NextEntityID) {
+            m_NextEntityID = reserved;
+            GrowEntities(reserved);
+        }
+    }
+
+    /**
+         * @brief Returns how many more entities can be created.
+         * For a registry without fixed capacity this is only limited by the ID range.
+         */
+    size_t GetRemainingEntityCapacity() const {
+        EntityID reserved = m_ReservedEntityID.load(std::memory_order_relaxed);
+        return static_cast<size_t>(m_MaxEntities - reserved) + m_FreeCount;
+    }
+
+    /**
+         * @brief Switches the registry to fixed capacity: at most `maxEntities` entities exist
+         * at once and every pool, existing or created later, holds at most `poolCapacity`
+         * components. The entity records, scratch buffers and pools are sized for that here, so
+         * entity and component churn does not allocate afterwards.
+         *
+         * @param maxEntities The maximum number of entities.
+         * @param poolCapacity The capacity of every component pool.
+         * @return `false` if the registry already exceeds these limits.
+         */
+    bool SetFixedCapacity(EntityID maxEntities, size_t poolCapacity) {
+        ASSERT(maxEntities > 0 && maxEntities < Traits::INDEX_MASK, "Invalid entity capacity.");
+        ASSERT(poolCapacity > 0, "Fixed pool capacity must be greater than 0.");
+        if (m_ReservedEntityID.load(std::memory_order_relaxed) > maxEntities) {
+            return false;
+        }
+
+        for (size_t i = 0; i < m_ComponentPools.size(); i++) {
+            if (!GetMutableComponentPool(static_cast<ComponentID>(i))
+                     .MakeFixed(poolCapacity, maxEntities)) {
+                return false;
+            }
+        }
+
+        m_MaxEntities = maxEntities;
+        m_PoolCapacity = poolCapacity;
+        m_Entities.reserve(maxEntities);
+        m_DeadScratch.reserve(maxEntities);
+        m_EntityScratch.reserve(maxEntities);
+        for (auto& pool : m_ComponentPools) {
+            if (pool->IsShared()) {
+                ReserveGroupScratch();
+            }
+        }
+        return true;
+    }
+
+    bool IsFixedCapacity() const { return m_PoolCapacity > 0; }
+
+    /**
+         * @brief Sets which free entity ID is reused first. IDs that are already free keep
+         * their place in the list.
+         */
+    void SetReusePolicy(ReusePolicy policy) { m_ReusePolicy = policy; }
+
+    ReusePolicy GetReusePolicy() const { return m_ReusePolicy; }
+
+    /**
+         * @brief Sets the shrink policy of every pool, including pools created later.
+         */
+    void SetShrinkPolicy(const ShrinkPolicy& policy) {
+        m_ShrinkPolicy = policy;
+        for (size_t i = 0; i < m_ComponentPools.size(); i++) {
+            GetMutableComponentPool(static_cast<ComponentID>(i)).SetShrinkPolicy(policy);
+        }
+    }
+
+    void SetShrinkPolicy(ComponentID componentID, const ShrinkPolicy& policy) {
+        GetMutableComponentPool(componentID).SetShrinkPolicy(policy);
+    }
+
+    /**
+         * @brief Sets the growth policy of every pool, including pools created later.
+         */
+    void SetGrowthPolicy(const GrowthPolicy& policy) {
+        m_GrowthPolicy = policy;
+        for (size_t i = 0; i < m_ComponentPools.size(); i++) {
+            GetMutableComponentPool(static_cast<ComponentID>(i)).SetGrowthPolicy(policy);
+        }
+    }
+
+    void SetGrowthPolicy(ComponentID componentID, const GrowthPolicy& policy) {
+        GetMutableComponentPool(componentID).SetGrowthPolicy(policy);
+    }
+
+    /**
+         * @brief Makes sure the pool can hold `capacity` components without growing.
+         *
+         * @param componentID The ID of the component.
+         * @param capacity The number of components to make room for.
+         * @return `false` if `capacity` is larger than a fixed pool capacity.
+         */
+    bool Reserve(ComponentID componentID, size_t capacity) {
+        return GetMutableComponentPool(componentID).Reserve(capacity);
+    }
+
+    /**
+         * @brief Closes the current frame for the adaptive growth policy of every pool.
+         * Pools still shared with a copy of the registry are skipped, as updating them
+         * would copy them.
+         */
+    void EndFrame() {
+        for (auto& pool : m_ComponentPools) {
+            if (pool.use_count() == 1) {
+                pool->EndFrame();
+            }
+        }
+    }
+
+    /**
+         * @brief Gives unused memory back: pools shrink to their live components and drop
+         * empty index pages, and the entity records and scratch buffers are trimmed.
+         * Pools shared with a copy of the registry are skipped, as shrinking would copy them.
+         * Fixed-capacity registries keep all of their memory.
+         */
+    void ShrinkToFit() {
+        if (IsFixedCapacity()) {
+            return;
+        }
+
+        for (auto& pool : m_ComponentPools) {
+            if (pool.use_count() == 1) {
+                pool->ShrinkToFit();
+            }
+        }
+
+        m_Entities.shrink_to_fit();
+        m_DeadScratch = Vector<bool>(m_pResource);
+        m_EntityScratch = Vector<EntityID>(m_pResource);
+        m_GroupScratch = GroupScratch(m_pResource);
+    }
+
     /**
          * @brief Creates a new entity with a name.
          * It checks if the name is already taken and returns the next available entity ID.
@@ -60,14 +342,13 @@ public:
          * @return The ID of the newly created/found entity.
          */
     EntityID CreateEntity(const std::string& name) {
-        EntityID id;
-
-        auto it = m_EntityNameMap.find(name);
-        if (it != m_EntityNameMap.end()) {
-            id = it->second;
-        } else {
+        EntityID id = m_Names.Find(name);
+        if (id == INVALID_ENTITY_ID) {
             id = CreateEntity();
-            m_EntityNameMap[name] = id;
+            if (id == INVALID_ENTITY_ID) {
+                return id;
+            }
+            m_Names.Insert(id, name);
 
             // Helios::logInfo("Entity created with name: %s.", name.c_str());
         }
@@ -77,7 +358,8 @@ public:
 
     // Releases an entity from the registry.
     // This does not destroy the entity, just puts it in the free list.
-    void Release(EntityID entityID) {}
+    // With generations, the index comes back with the next generation.
+    void Release(EntityID entityID) { PushFreeEntity(Traits::NextGeneration(entityID)); }
 
     /**
          * @brief Destroys an entity.
@@ -86,7 +368,280 @@ public:
          *
          * @param entityID The ID of the entity to destroy.
          */
-    void DestroyEntity(EntityID entityID) {}
+    void DestroyEntity(EntityID entityID) {
+        if (!ValidEntity(entityID)) {
+            return;
+        }
+
+        for (size_t i = 0; i < m_ComponentPools.size(); i++) {
+            RemoveComponent(entityID, static_cast<ComponentID>(i));
+        }
+
+        m_Names.Erase(entityID);
+        Release(entityID);
+    }
+
+    /**
+         * @brief Destroys many entities at once.
+         * Each pool either removes the few affected entities one by one, or is compacted in a
+         * single pass when a large part of it goes away. Pools that lose every entity are cleared.
+         * Outside of compacted pools, the work scales with the batch, not with the world.
+         *
+         * @param entityIDs The entities to destroy. Must not contain duplicates. IDs that are not
+         * valid, like stale handles, are skipped as by `DestroyEntity`.
+         * @param count The number of entities.
+         */
+    void DestroyEntities(const EntityID* entityIDs, size_t count) {
+        if (count == 0) {
+            return;
+        }
+
+        MECS_TRACE_SCOPE("Registry::DestroyEntities");
+
+        // The flags stay cleared between calls, so only the bits of the batch are touched
+        Vector<bool>& dead = m_DeadScratch;
+        if (dead.size() < m_NextEntityID) {
+            dead.resize(m_NextEntityID, false);
+        }
+        for (size_t i = 0; i < count; i++) {
+            // A stale handle must not mark the live entity that reuses its index
+            if (ValidEntity(entityIDs[i])) {
+                dead[Traits::GetIndex(entityIDs[i])] = true;
+            }
+        }
+
+        for (size_t i = 0; i < m_ComponentPools.size(); i++) {
+            // The cold part of a split component is removed along with the hot part
+            const ComponentPool& pool = *m_ComponentPools[i];
+            if (pool.GetCount() == 0 || pool.SharesIndex()) {
+                continue;
+            }
+
+            // Whichever of the pool and the batch is smaller is scanned
+            size_t affected = 0;
+            if (pool.GetCount() < count) {
+                for (size_t j = 0; j < pool.GetCount(); j++) {
+                    affected += dead[Traits::GetIndex(pool.GetEntityID(j))];
+                }
+            } else {
+                for (size_t j = 0; j < count; j++) { affected += pool.HasEntity(entityIDs[j]); }
+            }
+            if (affected == 0) {
+                continue;
+            }
+
+            ComponentID componentID = static_cast<ComponentID>(i);
+            if (affected == pool.GetCount()) {
+                ClearComponentPool(componentID, true);
+            } else if (affected * 4 < pool.GetCount()) {
+                for (size_t j = 0; j < count; j++) { RemoveComponent(entityIDs[j], componentID); }
+            } else {
+                // Compacting keeps the relative order, so both parts of a split stay in step
+                ComponentID partner = GetSplitPartner(componentID);
+                if (partner != INVALID_COMPONENT_ID) {
+                    GetMutableComponentPool(partner).RemoveComponents(dead);
+                }
+                GetMutableComponentPool(componentID).RemoveComponents(dead);
+            }
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            size_t index = Traits::GetIndex(entityIDs[i]);
+            if (index < dead.size()) {
+                dead[index] = false;
+            }
+            if (!ValidEntity(entityIDs[i])) {
+                continue;
+            }
+            m_Names.Erase(entityIDs[i]);
+            Release(entityIDs[i]);
+        }
+    }
+
+    /**
+         * @brief Destroys every entity that has all of the given components.
+         * The matching entities are gathered in a reused scratch buffer, then destroyed in bulk.
+         *
+         * @param componentIDs The components an entity needs to have to be destroyed.
+         * @param count The number of component IDs.
+         */
+    void DestroyAll(const ComponentID* componentIDs, size_t count) {
+        const ComponentPool& smallestPool =
+            *m_ComponentPools[GetSmallestComponentPoolID(componentIDs, count)];
+
+        Vector<EntityID>& entityIDs = m_EntityScratch;
+        entityIDs.clear();
+        for (size_t i = 0; i < smallestPool.GetCount(); i++) {
+            EntityID entityID = smallestPool.GetEntityID(i);
+            if (HasComponents(entityID, componentIDs, count)) {
+                entityIDs.push_back(entityID);
+            }
+        }
+
+        DestroyEntities(entityIDs.data(), entityIDs.size());
+    }
+
+    /**
+         * @brief Reports memory use and occupancy of every pool and the entity bookkeeping.
+         *
+         * @return The statistics.
+         */
+    WorldStats GetStats() const {
+        WorldStats stats;
+        stats.pools.reserve(m_ComponentPools.size());
+        for (auto& pool : m_ComponentPools) {
+            stats.pools.push_back(pool->GetStats());
+            stats.resizeCount += stats.pools.back().resizeCount;
+            stats.denseBytes += stats.pools.back().denseBytes;
+            stats.mappedBytes += stats.pools.back().mappedBytes;
+            stats.indexBytes += stats.pools.back().indexBytes;
+        }
+
+        stats.freeEntityCount = m_FreeCount;
+        stats.entityCount = m_NextEntityID - stats.freeEntityCount;
+        stats.freeListBytes = m_Entities.capacity() * sizeof(EntityID);
+
+        stats.nameCount = m_Names.GetCount();
+        stats.nameBytes = m_Names.GetMemoryUsage();
+
+        stats.singletonCount = m_Singletons.GetCount();
+        stats.singletonBytes = m_Singletons.GetCapacity();
+
+        return stats;
+    }
+
+    /**
+         * @brief Reports the access counters of every pool, see `Profile.h`.
+         * Empty when built without `MECS_ENABLE_PROFILE`.
+         *
+         * @param largeComponentBytes Components at least this large can be flagged for splitting.
+         * @param cohesionThreshold Flags components whose passes touch less than this share of
+         * their fields on average.
+         * @return The report.
+         */
+    AccessReport GetAccessReport(size_t largeComponentBytes, float cohesionThreshold) const {
+        AccessReport report;
+#if defined(MECS_ENABLE_PROFILE)
+        report.pools.reserve(m_ComponentPools.size());
+        for (auto& pool : m_ComponentPools) {
+            PoolAccessStats stats;
+            stats.name = std::string(pool->GetName());
+            stats.componentSize = pool->GetComponentSize();
+            stats.fieldCount = pool->GetFieldCount();
+            stats.counters = pool->GetAccessCounters();
+            AnalyzeAccess(stats, largeComponentBytes, cohesionThreshold);
+            report.pools.push_back(std::move(stats));
+        }
+#else
+        (void)largeComponentBytes;
+        (void)cohesionThreshold;
+#endif
+        return report;
+    }
+
+    /**
+         * @brief Zeroes the access counters of every pool. Does nothing without
+         * `MECS_ENABLE_PROFILE`.
+         */
+    void ResetAccessCounters() const {
+#if defined(MECS_ENABLE_PROFILE)
+        for (auto& pool : m_ComponentPools) { pool->ResetAccessCounters(); }
+#endif
+    }
+
+    /**
+         * @brief Builds a pool around an existing array of components.
+         * See `ComponentPool::ImportComponents`.
+         *
+         * @param componentID The ID of the component.
+         * @param entityIDs The entity owning each component. All must be valid entities.
+         * @param data `count` packed components.
+         * @param count The number of components.
+         * @param ownership Whether the data is copied, borrowed or adopted by the pool.
+         * @return `false` if a fixed-capacity pool cannot take the data.
+         */
+    bool ImportComponents(ComponentID componentID, const EntityID* entityIDs, void* data,
+                          size_t count, Ownership ownership) {
+        ASSERT(GetSplitPartner(componentID) == INVALID_COMPONENT_ID,
+               "Split components cannot be imported.");
+        for (size_t i = 0; i < count; i++) {
+            ASSERT(ValidEntity(entityIDs[i]), "Imported components must belong to valid entities.");
+        }
+
+        return GetMutableComponentPool(componentID)
+            .ImportComponents(entityIDs, data, count, ownership);
+    }
+
+    /**
+         * @brief Removes every component from a pool, see `ComponentPool::Clear`.
+         * A pool shared with a copy of the registry is replaced by an empty one instead of
+         * being duplicated first.
+         *
+         * @param componentID The ID of the component.
+         * @param keepCapacity Whether the pool keeps its memory for reuse.
+         */
+    void ClearComponentPool(ComponentID componentID, bool keepCapacity) {
+        ClearPool(componentID, keepCapacity);
+
+        // Both parts of a split component are cleared, and fresh pools are linked again
+        ComponentID partner = GetSplitPartner(componentID);
+        if (partner != INVALID_COMPONENT_ID) {
+            ClearPool(partner, keepCapacity);
+            ShareSplitIndex(componentID);
+        }
+    }
+
+    /**
+         * @brief Returns the other part of a split component (see `SplitComponent`), or
+         * `INVALID_COMPONENT_ID` if the component is not split.
+         */
+    ComponentID GetSplitPartner(ComponentID componentID) const {
+        return componentID < m_SplitLinks.size() ? m_SplitLinks[componentID].partner
+                                                 : INVALID_COMPONENT_ID;
+    }
+
+    /**
+         * @brief Destroys every entity and empties every pool.
+         * Component types stay registered and singleton components are kept.
+         *
+         * @param keepCapacity Whether the pools keep their memory for reuse.
+         */
+    void Clear(bool keepCapacity) {
+        MECS_TRACE_SCOPE("Registry::Clear");
+
+        for (size_t i = 0; i < m_ComponentPools.size(); i++) {
+            ClearComponentPool(static_cast<ComponentID>(i), keepCapacity);
+        }
+
+        m_Names.Clear();
+        m_FreeHead = NULL_INDEX;
+        m_FreeTail = NULL_INDEX;
+        m_FreeCount = 0;
+
+        // With generations, every index goes back on the free list with its next generation,
+        // so handles from before the clear stay invalid. New indices keep coming from the
+        // counter with generation 0, which is what other threads reserve from.
+        // Without generations, indices start over unless another thread still holds a
+        // reservation. The counter then keeps counting and the cleared indices are freed, so
+        // no reserved ID is handed out twice.
+        if constexpr (Traits::GENERATION_BITS > 0) {
+            FlushReservedEntities();
+            for (EntityID index = 0; index < m_NextEntityID; index++) {
+                PushFreeEntity(Traits::MakeID(static_cast<EntityIndex>(index),
+                                              Traits::GetGeneration(m_Entities[index]) + 1));
+            }
+        } else {
+            EntityID next = m_NextEntityID;
+            if (m_ReservedEntityID.compare_exchange_strong(next, 0, std::memory_order_relaxed)) {
+                m_Entities.clear();
+                m_NextEntityID = 0;
+            } else {
+                for (EntityID index = 0; index < m_NextEntityID; index++) {
+                    PushFreeEntity(index);
+                }
+            }
+        }
+    }
 
     /**
          * @brief Retrieves the entity composition of the given entity ID.
@@ -97,22 +652,17 @@ public:
     std::vector<std::string> GetEntityType(EntityID entityID) const {
         std::vector<std::string> entityTypes;
         for (auto& component : m_ComponentPools) {
-            if (component.HasEntity(entityID)) {
-                entityTypes.push_back(component.GetName());
+            if (component->HasEntity(entityID)) {
+                entityTypes.push_back(component->GetName());
             }
         }
 
         return entityTypes;
     }
 
-    EntityID GetEntityIDByName(const std::string& name) const {
-        auto it = m_EntityNameMap.find(name);
-        if (it != m_EntityNameMap.end()) {
-            return it->second;
-        }
+    EntityID GetEntityIDByName(const std::string& name) const { return m_Names.Find(name); }
 
-        return INVALID_ENTITY_ID;
-    }
+    EntityID GetEntityIDByName(const HashedName& name) const { return m_Names.Find(name); }
 
     /**
          * @brief Adds a component to an entity.
@@ -125,7 +675,42 @@ public:
          * @return A void pointer to the added component data.
          */
     void* AddComponent(EntityID entityID, ComponentID componentID, const void* componentData) {
-        return m_ComponentPools[componentID].AddComponent(entityID, componentData);
+        if (GetSplitPartner(componentID) != INVALID_COMPONENT_ID) {
+            void* component = nullptr;
+            AddSplitComponents(&entityID, 1, componentID, componentData, &component);
+            return component;
+        }
+
+        return GetMutableComponentPool(componentID).AddComponent(entityID, componentData);
+    }
+
+    /**
+         * @brief Adds the same component data to many entities at once.
+         * Internal function without type information.
+         *
+         * @param entityIDs The entities to add the component to. None of them may have it yet.
+         * @param count The number of entities.
+         * @param componentID The ID of the component.
+         * @param componentData A pointer to the component data copied to every entity.
+         * @return `false` if the components do not fit in a fixed-capacity pool.
+         */
+    bool AddComponents(const EntityID* entityIDs, size_t count, ComponentID componentID,
+                       const void* componentData) {
+        if (GetSplitPartner(componentID) != INVALID_COMPONENT_ID) {
+            return AddSplitComponents(entityIDs, count, componentID, componentData, nullptr);
+        }
+
+        return GetMutableComponentPool(componentID).AddComponents(entityIDs, count, componentData);
+    }
+
+    /**
+         * @brief Checks if `count` more components fit in a pool. Always `true` unless the
+         * registry has fixed capacity.
+         */
+    bool HasRoomFor(ComponentID componentID, size_t count) const {
+        ComponentID partner = GetSplitPartner(componentID);
+        return m_ComponentPools[componentID]->HasRoomFor(count) &&
+               (partner == INVALID_COMPONENT_ID || m_ComponentPools[partner]->HasRoomFor(count));
     }
 
     /**
@@ -142,7 +727,7 @@ public:
         if (!HasComponent(entityID, componentID)) {
             AddComponent(entityID, componentID, componentData);
         } else {
-            m_ComponentPools[componentID].SetComponent(entityID, componentData);
+            GetMutableComponentPool(componentID).SetComponent(entityID, componentData);
         }
     }
 
@@ -154,9 +739,20 @@ public:
          * @param componentID The ID of the component to remove.
          */
     void RemoveComponent(EntityID entityID, ComponentID componentID) {
-        if (HasComponent(entityID, componentID)) {
-            m_ComponentPools[componentID].RemoveComponent(entityID);
+        if (!HasComponent(entityID, componentID)) {
+            return;
+        }
+
+        // The cold part of a split goes first, as it looks the entity up in the hot index
+        ComponentID partner = GetSplitPartner(componentID);
+        if (partner != INVALID_COMPONENT_ID) {
+            bool hot = m_SplitLinks[componentID].hot;
+            GetMutableComponentPool(hot ? partner : componentID).RemoveComponent(entityID);
+            GetMutableComponentPool(hot ? componentID : partner).RemoveComponent(entityID);
+            return;
         }
+
+        GetMutableComponentPool(componentID).RemoveComponent(entityID);
     }
 
     /**
@@ -167,10 +763,10 @@ public:
          * @return True if the entity has the component, false otherwise.
          */
     bool HasComponent(EntityID entityID, ComponentID componentID) const {
-        return m_ComponentPools[componentID].HasEntity(entityID);
+        return m_ComponentPools[componentID]->HasEntity(entityID);
     }
 
-    bool HasComponents(EntityID entityID, ComponentID* componentIDs, size_t count) const {
+    bool HasComponents(EntityID entityID, const ComponentID* componentIDs, size_t count) const {
         for (size_t i = 0; i < count; i++) {
             // Helios::logDebug("ComponentID: %d", componentIDs[i]);
             if (!HasComponent(entityID, componentIDs[i])) {
@@ -183,7 +779,7 @@ public:
 
     const void* GetComponent(EntityID entityID, ComponentID componentID) const {
         if (HasComponent(entityID, componentID)) {
-            return m_ComponentPools[componentID].GetComponent(entityID);
+            return m_ComponentPools[componentID]->GetComponent(entityID);
         } else {
             return nullptr;
         }
@@ -191,49 +787,104 @@ public:
 
     void* GetMutComponent(EntityID entityID, ComponentID componentID) {
         if (HasComponent(entityID, componentID)) {
-            return m_ComponentPools[componentID].GetMutComponent(entityID);
+            return GetMutableComponentPool(componentID).GetMutComponent(entityID);
         } else {
             return nullptr;
         }
     }
 
+    /**
+     * @brief Returns a component pool for modification.
+     * If the pool is shared with a copy of this registry, it is duplicated first, so readers
+     * should go through the const overload.
+     */
     ComponentPool& GetComponentPool(ComponentID componentID) {
-        return m_ComponentPools[componentID];
+        return GetMutableComponentPool(componentID);
     }
 
-    ComponentPool& GetSmallestComponentPool(ComponentID* componentIDs, size_t count) {
-        size_t smallestSize = m_ComponentPools[componentIDs[0]].GetCount();
+    const ComponentPool& GetComponentPool(ComponentID componentID) const {
+        return *m_ComponentPools[componentID];
+    }
+
+    /**
+     * @brief Returns the number of registered component pools.
+     * ComponentIDs are the indices `[0, GetComponentPoolCount())`.
+     */
+    size_t GetComponentPoolCount() const { return m_ComponentPools.size(); }
+
+    EntityID GetNextEntityID() const { return m_NextEntityID; }
+
+    /**
+     * @brief Writes the IDs waiting for reuse to `out`, in the order they are handed out.
+     * Each ID holds the generation its index comes back with.
+     */
+    void GetFreeEntities(std::vector<EntityID>& out) const {
+        out.clear();
+        out.reserve(m_FreeCount);
+        for (EntityID index = m_FreeHead; index != NULL_INDEX;
+             index = Traits::GetIndex(m_Entities[index])) {
+            out.push_back(Traits::MakeID(static_cast<EntityIndex>(index),
+                                         Traits::GetGeneration(m_Entities[index])));
+        }
+    }
+
+    std::pmr::memory_resource* GetMemoryResource() const { return m_pResource; }
+
+    /**
+     * @brief The buffers `View::EachGroup` sorts entities in, kept so grouping every frame
+     * does not allocate.
+     */
+    struct GroupScratch {
+        explicit GroupScratch(
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : keys(resource), ends(resource), entities(resource) {}
+
+        Vector<SharedIndex> keys;  // Per dense index of the shared pool
+        Vector<size_t> ends;       // Per shared value
+        Vector<EntityID> entities; // Grouped by value
+    };
+
+    /**
+     * @brief Returns the scratch of `View::EachGroup`. A fixed-capacity registry sizes it for
+     * a full pool when its first shared component is registered.
+     */
+    GroupScratch& GetGroupScratch() { return m_GroupScratch; }
+
+    const ComponentPool& GetSmallestComponentPool(const ComponentID* componentIDs,
+                                                  size_t count) const {
+        return *m_ComponentPools[GetSmallestComponentPoolID(componentIDs, count)];
+    }
+
+    ComponentID GetSmallestComponentPoolID(const ComponentID* componentIDs, size_t count) const {
+        size_t smallestSize = m_ComponentPools[componentIDs[0]]->GetCount();
         ComponentID smallestComponentID = componentIDs[0];
         for (size_t i = 1; i < count; i++) {
-            if (m_ComponentPools[componentIDs[i]].GetCount() < smallestSize) {
-                smallestSize = m_ComponentPools[componentIDs[i]].GetCount();
+            if (m_ComponentPools[componentIDs[i]]->GetCount() < smallestSize) {
+                smallestSize = m_ComponentPools[componentIDs[i]]->GetCount();
                 smallestComponentID = componentIDs[i];
             }
         }
 
-        return m_ComponentPools[smallestComponentID];
+        return smallestComponentID;
     }
 
-    // TODO: store class instead of simply void* to store extra info
-    void* SetSingletonComponent(const void* componentData, std::type_index typeIndex,
-                                size_t componentSize, size_t alignment) {
-        if (m_SingletonComponents.count(typeIndex) > 0) {
-            return m_SingletonComponents.at(typeIndex);
-        }
-
-        void* newData = ::operator new(componentSize, std::align_val_t(alignment));
-        memcpy(newData, componentData, componentSize);
-        m_SingletonComponents[typeIndex] = newData;
-
-        return m_SingletonComponents.at(typeIndex);
+    /**
+         * @brief Sets a singleton component, overwriting its previous value.
+         *
+         * @param componentData The value to copy.
+         * @param typeID The singleton type ID, see `SingletonStore::TypeID`.
+         * @param componentSize The size of the component type.
+         * @param alignment The alignment of the component type.
+         * @return A pointer to the stored singleton.
+         */
+    void* SetSingletonComponent(const void* componentData, size_t typeID, size_t componentSize,
+                                size_t alignment) {
+        return m_Singletons.Set(typeID, componentData, componentSize, alignment);
     }
 
-    const void* GetSingletonComponent(std::type_index typeIndex) const {
-        if (m_SingletonComponents.count(typeIndex) == 0) {
-            return nullptr;
-        }
-        return m_SingletonComponents.at(typeIndex);
-    }
+    const void* GetSingletonComponent(size_t typeID) const { return m_Singletons.Get(typeID); }
+
+    void* GetMutSingletonComponent(size_t typeID) { return m_Singletons.Get(typeID); }
 
     /**
          * @brief Returns the ID of a component type.
@@ -254,41 +905,893 @@ public:
             return m_ComponentTypeMap[typeIndex];
         }
 
+        // Both parts of a split component are registered together
+        if constexpr (IS_SPLIT<T>) {
+            return RegisterSplitComponent<T>();
+        } else {
+            return RegisterComponentType<T>();
+        }
+    }
+
+    /**
+         * @brief Checks if an entity exists. The record of a destroyed entity holds a link of
+         * the free list instead of its ID, so destroyed entities are not valid.
+         */
+    bool ValidEntity(EntityID entityID) const {
+        return entityID != INVALID_ENTITY_ID && Traits::GetIndex(entityID) < m_NextEntityID &&
+               m_Entities[Traits::GetIndex(entityID)] == entityID;
+    }
+
+    std::string GetEntityName(EntityID entityID) const {
+        return std::string(m_Names.GetName(entityID));
+    }
+
+    /**
+     * @brief Writes every pool, entity name and the entity ID state into a world image.
+     * See `WorldImage.h` for the layout.
+     *
+     * @param path The file to write.
+     * @return `true` on success, `false` if the file could not be written.
+     */
+    bool SaveImage(const std::string& path) const {
+        // Entity IDs waiting for reuse, in the order they are handed out
+        std::vector<EntityID> freeList;
+        GetFreeEntities(freeList);
+
+        std::string strings;
+        std::vector<ImagePool> pools(m_ComponentPools.size());
+        std::vector<ImageEntityName> names;
+        names.reserve(m_Names.GetCount());
+
+        ImageHeader header = {};
+        std::memcpy(header.magic, IMAGE_MAGIC, sizeof(header.magic));
+        header.version = IMAGE_VERSION;
+        header.pageSize = static_cast<uint32_t>(IMAGE_PAGE_SIZE);
+        header.poolCount = static_cast<uint32_t>(m_ComponentPools.size());
+        header.nextEntityID = m_NextEntityID;
+        header.nameCount = m_Names.GetCount();
+        header.freeCount = freeList.size();
+        header.entityIDSize = sizeof(EntityID);
+        header.indexBits = Traits::INDEX_BITS;
+
+        m_Names.ForEach([&](EntityID entityID, std::string_view name) {
+            names.push_back({ entityID, strings.size(), name.size() });
+            strings.append(name.data(), name.size());
+        });
+
+        for (size_t i = 0; i < m_ComponentPools.size(); i++) {
+            const ComponentPool& pool = *m_ComponentPools[i];
+            std::string name = pool.GetName();
+            pools[i].nameOffset = strings.size();
+            pools[i].nameLength = name.size();
+            pools[i].componentSize = pool.GetComponentSize();
+            pools[i].alignment = pool.GetAlignment();
+            pools[i].count = pool.GetCount();
+            strings += name;
+        }
+
+        // Lay out the tables, then the page-aligned columns
+        uint64_t offset = sizeof(ImageHeader);
+        header.poolTableOffset = offset;
+        offset += sizeof(ImagePool) * pools.size();
+        header.namesOffset = offset;
+        offset += sizeof(ImageEntityName) * names.size();
+        header.freeListOffset = offset;
+        offset += sizeof(EntityID) * freeList.size();
+        header.stringsOffset = offset;
+        header.stringsSize = strings.size();
+        offset += strings.size();
+
+        for (ImagePool& pool : pools) {
+            pool.entitiesOffset = AlignUp(offset, alignof(EntityID));
+            offset = pool.entitiesOffset + sizeof(EntityID) * pool.count;
+
+            // Tags have no column, only their entities
+            pool.componentsOffset = AlignUp(offset, IMAGE_PAGE_SIZE);
+            if (pool.componentSize == 0) {
+                pool.capacity = pool.count;
+                offset = pool.componentsOffset;
+                continue;
+            }
+
+            uint64_t columnBytes =
+                AlignUp(std::max<uint64_t>(pool.count, 1) * pool.componentSize, IMAGE_PAGE_SIZE);
+            pool.capacity = columnBytes / pool.componentSize;
+            offset = pool.componentsOffset + columnBytes;
+        }
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+
+        auto writeAt = [&file](uint64_t at, const void* data, size_t size) {
+            file.seekp(static_cast<std::streamoff>(at));
+            file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        };
+
+        writeAt(0, &header, sizeof(header));
+        writeAt(header.poolTableOffset, pools.data(), sizeof(ImagePool) * pools.size());
+        writeAt(header.namesOffset, names.data(), sizeof(ImageEntityName) * names.size());
+        writeAt(header.freeListOffset, freeList.data(), sizeof(EntityID) * freeList.size());
+        writeAt(header.stringsOffset, strings.data(), strings.size());
+
+        // Every pool is written with one call per table. Scratch comes from the default
+        // resource like the tables, as a fixed-capacity slab never gets it back.
+        std::vector<EntityID> entities;
+        std::vector<uint8_t> packed;
+        for (size_t i = 0; i < pools.size(); i++) {
+            const ComponentPool& pool = *m_ComponentPools[i];
+            entities.resize(pools[i].count);
+            for (size_t j = 0; j < entities.size(); j++) { entities[j] = pool.GetEntityID(j); }
+            writeAt(pools[i].entitiesOffset, entities.data(), sizeof(EntityID) * entities.size());
+            if (pool.IsPacked()) {
+                writeAt(pools[i].componentsOffset, pool.Data(),
+                        pools[i].count * pools[i].componentSize);
+                continue;
+            }
+
+            // The image keeps packed components, so SoA and shared pools are gathered first
+            packed.resize(pools[i].count * pools[i].componentSize);
+            pool.ReadComponents(packed.data());
+            writeAt(pools[i].componentsOffset, packed.data(), packed.size());
+        }
+
+        // Extend the file over the padding of the last column
+        if (!pools.empty()) {
+            const char zero = 0;
+            writeAt(offset - 1, &zero, 1);
+        }
+
+        return static_cast<bool>(file);
+    }
+
+    /**
+     * @brief Loads a world image by mapping it into memory.
+     * Component columns are not copied: pools point straight into the mapping, and pages are
+     * faulted in lazily. A pool is promoted to owned memory when it first grows past the
+     * mapped capacity (or, for `MapMode::ReadOnly`, on its first write).
+     *
+     * Pools are matched to component types by name when the types are first used.
+     *
+     * @warning The registry must not contain any entities yet.
+     *
+     * @param path The world image to load.
+     * @param mode Whether the mapping is read-only or copy-on-write.
+     * @return `true` on success, `false` if the file could not be mapped or is not a valid image.
+     */
+    bool LoadImage(const std::string& path, MapMode mode) {
+        ASSERT(m_NextEntityID == m_FreeCount,
+               "World images can only be loaded into an empty registry.");
+
+        auto mapping = std::make_shared<FileMapping>();
+        if (!mapping->Open(path, mode)) {
+            return false;
+        }
+
+        const uint8_t* base = static_cast<const uint8_t*>(mapping->Data());
+        size_t size = mapping->Size();
+        auto inBounds = [size](uint64_t offset, uint64_t bytes) {
+            return offset <= size && bytes <= size - offset;
+        };
+        // `count` elements of `elementSize` bytes, without overflowing the multiplication
+        auto arrayInBounds = [size](uint64_t offset, uint64_t count, uint64_t elementSize) {
+            return offset <= size && (elementSize == 0 || count <= (size - offset) / elementSize);
+        };
+        auto inStrings = [](uint64_t offset, uint64_t length, uint64_t stringsSize) {
+            return offset <= stringsSize && length <= stringsSize - offset;
+        };
+
+        if (!inBounds(0, sizeof(ImageHeader))) {
+            return false;
+        }
+
+        ImageHeader header;
+        std::memcpy(&header, base, sizeof(header));
+        if (std::memcmp(header.magic, IMAGE_MAGIC, sizeof(header.magic)) != 0 ||
+            header.version != IMAGE_VERSION || header.pageSize != IMAGE_PAGE_SIZE ||
+            header.entityIDSize != sizeof(EntityID) || header.indexBits != Traits::INDEX_BITS ||
+            header.nextEntityID > m_MaxEntities ||
+            !arrayInBounds(header.poolTableOffset, header.poolCount, sizeof(ImagePool)) ||
+            !arrayInBounds(header.namesOffset, header.nameCount, sizeof(ImageEntityName)) ||
+            !arrayInBounds(header.freeListOffset, header.freeCount, sizeof(EntityID)) ||
+            !inBounds(header.stringsOffset, header.stringsSize) ||
+            header.poolTableOffset % alignof(ImagePool) != 0 ||
+            header.namesOffset % alignof(ImageEntityName) != 0 ||
+            header.freeListOffset % alignof(EntityID) != 0) {
+            return false;
+        }
+
+        const char* strings = reinterpret_cast<const char*>(base + header.stringsOffset);
+        const ImagePool* pools = reinterpret_cast<const ImagePool*>(base + header.poolTableOffset);
+        const ImageEntityName* names =
+            reinterpret_cast<const ImageEntityName*>(base + header.namesOffset);
+        bool readOnly = mode == MapMode::ReadOnly;
+
+        // Every record is checked before the first pool points into the mapping, which is
+        // released if the image is rejected. Columns are page aligned, so any component
+        // alignment up to a page holds in the mapping.
+        size_t newPools = 0;
+        for (uint32_t i = 0; i < header.poolCount; i++) {
+            const ImagePool& image = pools[i];
+            if (!inStrings(image.nameOffset, image.nameLength, header.stringsSize) ||
+                image.count > image.capacity || image.alignment == 0 ||
+                (image.alignment & (image.alignment - 1)) != 0 ||
+                image.alignment > IMAGE_PAGE_SIZE || image.componentSize % image.alignment != 0 ||
+                image.componentsOffset % IMAGE_PAGE_SIZE != 0 ||
+                image.entitiesOffset % alignof(EntityID) != 0 ||
+                !arrayInBounds(image.entitiesOffset, image.count, sizeof(EntityID)) ||
+                !arrayInBounds(image.componentsOffset, image.capacity, image.componentSize)) {
+                return false;
+            }
+
+            // A registered component must have the layout of the image
+            std::string name(strings + image.nameOffset, image.nameLength);
+            bool found = false;
+            for (const auto& pool : m_ComponentPools) {
+                if (pool->GetName() == name) {
+                    found = true;
+                    if (pool->GetComponentSize() != image.componentSize ||
+                        pool->GetAlignment() != image.alignment) {
+                        return false;
+                    }
+                }
+            }
+            newPools += !found;
+        }
+        if (m_ComponentPools.size() + newPools > MAX_COMPONENT_TYPES) {
+            return false;
+        }
+        for (uint64_t i = 0; i < header.nameCount; i++) {
+            if (!inStrings(names[i].nameOffset, names[i].nameLength, header.stringsSize)) {
+                return false;
+            }
+        }
+
+        // Both parts of a split are stored as plain pools, and linked again once loaded
+        UnlinkSplitComponents();
+
+        for (uint32_t i = 0; i < header.poolCount; i++) {
+            const ImagePool& image = pools[i];
+            std::string name(strings + image.nameOffset, image.nameLength);
+            ComponentPool& pool = FindOrCreateComponentPool(name, image.componentSize,
+                                                            image.alignment);
+            ASSERT(pool.GetCount() == 0, "World image pools must be loaded into empty pools.");
+
+            void* components = const_cast<uint8_t*>(base) + image.componentsOffset;
+            pool.MapComponents(components, image.count, image.capacity, readOnly);
+            pool.AssignEntities(reinterpret_cast<const EntityID*>(base + image.entitiesOffset),
+                                image.count);
+        }
+
+        // The image brings its own records, generations and free list
+        m_Entities.clear();
+        m_FreeHead = NULL_INDEX;
+        m_FreeTail = NULL_INDEX;
+        m_FreeCount = 0;
+        m_NextEntityID = static_cast<EntityID>(header.nextEntityID);
+        m_ReservedEntityID.store(m_NextEntityID, std::memory_order_relaxed);
+        GrowEntities(m_NextEntityID);
+        for (auto& pool : m_ComponentPools) {
+            for (size_t i = 0; i < pool->GetCount(); i++) { SyncEntity(pool->GetEntityID(i)); }
+        }
+        LinkSplitComponents();
+
+        for (uint64_t i = 0; i < header.nameCount; i++) {
+            m_Names.Insert(static_cast<EntityID>(names[i].entityID),
+                           std::string_view(strings + names[i].nameOffset, names[i].nameLength));
+        }
+
+        const EntityID* freeList = reinterpret_cast<const EntityID*>(base + header.freeListOffset);
+        for (uint64_t i = 0; i < header.freeCount; i++) {
+            GrowEntities(static_cast<size_t>(Traits::GetIndex(freeList[i])) + 1);
+            AppendFreeEntity(freeList[i]);
+        }
+
+        m_pImage = std::move(mapping);
+
+        return true;
+    }
+
+    /**
+     * @brief Compares the free list with the one a snapshot was taken with (see
+     * `GetFreeEntities`), for a delta.
+     *
+     * @param previousFree The free list at the time of the snapshot.
+     * @param created Receives the entities whose index was free then and is live now.
+     * @param destroyed Receives the free list entries that are new, in free list order.
+     */
+    void DiffEntities(const std::vector<EntityID>& previousFree, std::vector<EntityID>& created,
+                      std::vector<EntityID>& destroyed) const {
+        std::unordered_map<EntityID, EntityID> previous;
+        for (EntityID entityID : previousFree) { previous[Traits::GetIndex(entityID)] = entityID; }
+
+        for (EntityID entityID : previousFree) {
+            EntityID index = Traits::GetIndex(entityID);
+            if (index < m_Entities.size() && !IsFreeRecord(index)) {
+                created.push_back(m_Entities[index]);
+            }
+        }
+
+        // An index that was freed, reused and freed again comes back with a new generation
+        for (EntityID index = m_FreeHead; index != NULL_INDEX;
+             index = Traits::GetIndex(m_Entities[index])) {
+            EntityID entityID = Traits::MakeID(static_cast<EntityIndex>(index),
+                                               Traits::GetGeneration(m_Entities[index]));
+            auto it = previous.find(index);
+            if (it == previous.end() || it->second != entityID) {
+                destroyed.push_back(entityID);
+            }
+        }
+    }
+
+    /**
+     * @brief Applies a delta produced by `World::Diff` to this registry.
+     * Pools are matched by component name, so the two worlds may have registered their
+     * component types in a different order.
+     *
+     * @param delta The changes to apply.
+     */
+    void ApplyDelta(const WorldDelta& delta) {
+        FlushReservedEntities();
+        UnlinkSplitComponents();
+        for (const PoolDelta& poolDelta : delta.pools) {
+            ComponentPool& pool = FindOrCreateComponentPool(poolDelta.name, poolDelta.componentSize,
+                                                            poolDelta.alignment);
+
+            for (EntityID entityID : poolDelta.removed) {
+                if (pool.HasEntity(entityID)) {
+                    pool.RemoveComponent(entityID);
+                }
+            }
+
+            // Tags have no data, so any pointer stands in for it
+            static const uint8_t NO_DATA = 0;
+            size_t size = poolDelta.componentSize;
+            for (size_t i = 0; i < poolDelta.added.size(); i++) {
+                const uint8_t* data = size == 0 ? &NO_DATA : poolDelta.addedData.data() + i * size;
+                if (pool.HasEntity(poolDelta.added[i])) {
+                    pool.SetComponent(poolDelta.added[i], data);
+                } else {
+                    pool.AddComponent(poolDelta.added[i], data);
+                }
+                SyncEntity(poolDelta.added[i]);
+            }
+
+            for (const ByteRange& range : poolDelta.modified) {
+                if (!pool.HasEntity(range.entityID)) {
+                    continue;
+                }
+                pool.PatchComponent(range.entityID, range.offset,
+                                    poolDelta.rangeData.data() + range.dataOffset, range.length);
+            }
+
+            pool.SetSorted(false);
+        }
+        LinkSplitComponents();
+
+        if (delta.nextEntityID > m_NextEntityID) {
+            m_NextEntityID = delta.nextEntityID;
+            m_ReservedEntityID.store(m_NextEntityID, std::memory_order_relaxed);
+            GrowEntities(m_NextEntityID);
+        }
+
+        // Entities without components only show up here. `destroyed` is in free list order,
+        // which a LIFO list builds from the front.
+        for (EntityID entityID : delta.created) { SyncEntity(entityID); }
+        if (m_ReusePolicy == ReusePolicy::Lifo) {
+            for (size_t i = delta.destroyed.size(); i-- > 0;) {
+                SyncFreeEntity(delta.destroyed[i]);
+            }
+        } else {
+            for (EntityID entityID : delta.destroyed) { SyncFreeEntity(entityID); }
+        }
+    }
+
+private:
+    // Ends the free list. The all-ones index is never handed out, see `IDTraits::INDEX_MASK`.
+    static constexpr EntityID NULL_INDEX = Traits::INDEX_MASK;
+
+    void Swap(BasicRegistry& other) noexcept {
+        // Containers take their allocator along, so they swap in O(1) across resources
+        std::swap(m_pResource, other.m_pResource);
+        std::swap(m_pImage, other.m_pImage);
+        std::swap(m_ComponentPools, other.m_ComponentPools);
+        std::swap(m_ComponentTypeMap, other.m_ComponentTypeMap);
+        m_Singletons.Swap(other.m_Singletons);
+        std::swap(m_Names, other.m_Names);
+        std::swap(m_Entities, other.m_Entities);
+        std::swap(m_FreeHead, other.m_FreeHead);
+        std::swap(m_FreeTail, other.m_FreeTail);
+        std::swap(m_FreeCount, other.m_FreeCount);
+        std::swap(m_ReusePolicy, other.m_ReusePolicy);
+        std::swap(m_NextEntityID, other.m_NextEntityID);
+        EntityID reserved = m_ReservedEntityID.load(std::memory_order_relaxed);
+        m_ReservedEntityID.store(other.m_ReservedEntityID.load(std::memory_order_relaxed),
+                                 std::memory_order_relaxed);
+        other.m_ReservedEntityID.store(reserved, std::memory_order_relaxed);
+        std::swap(m_MaxEntities, other.m_MaxEntities);
+        std::swap(m_PoolCapacity, other.m_PoolCapacity);
+        std::swap(m_UnboundComponentMap, other.m_UnboundComponentMap);
+        std::swap(m_DeadScratch, other.m_DeadScratch);
+        std::swap(m_EntityScratch, other.m_EntityScratch);
+        std::swap(m_GroupScratch, other.m_GroupScratch);
+        std::swap(m_ShrinkPolicy, other.m_ShrinkPolicy);
+        std::swap(m_GrowthPolicy, other.m_GrowthPolicy);
+        std::swap(m_SplitLinks, other.m_SplitLinks);
+        std::swap(m_SplitDefaults, other.m_SplitDefaults);
+    }
+
+    /**
+     * @brief Empties a pool. A pool that is shared with a copy of the registry is replaced by
+     * a new, empty one instead.
+     */
+    void ClearPool(ComponentID componentID, bool keepCapacity) {
+        std::shared_ptr<ComponentPool>& pool = m_ComponentPools[componentID];
+        if (pool.use_count() > 1) {
+            std::shared_ptr<ComponentPool> cleared =
+                MakeComponentPool(pool->GetComponentSize(), pool->GetAlignment(), pool->GetName(),
+                                  pool->GetFields(), pool->GetFieldCount(), pool->IsShared());
+            cleared->SetShrinkPolicy(pool->GetShrinkPolicy());
+            cleared->SetGrowthPolicy(pool->GetGrowthPolicy());
+            pool = std::move(cleared);
+            return;
+        }
+
+        pool->Clear(keepCapacity);
+    }
+
+    /**
+     * @brief Registers a component type that is not split: binds the pool of a loaded world
+     * image, or creates a new pool.
+     */
+    template <typename T>
+    ComponentID RegisterComponentType() {
+        static_assert(!IS_SHARED<T> || (!IS_SOA<T> && !IS_SPLIT<T> && !std::is_empty_v<T>),
+                      "Shared components cannot be tags, SoA or split.");
+
         if (m_ComponentTypeMap.size() >= MAX_COMPONENT_TYPES) {
             // TODO: this might need to be an assert!
             // Helios::logError("Maximum number of component types reached.");
             return INVALID_COMPONENT_ID;
         }
 
-        m_ComponentPools.emplace_back(sizeof(T), alignof(T), typeid(T).name());
+        std::type_index typeIndex = typeid(T);
+
+        // A pool for this type may already exist if it was created by loading a world image
+        auto unbound = m_UnboundComponentMap.find(MakeString(typeid(T).name()));
+        if (unbound != m_UnboundComponentMap.end()) {
+            ComponentID componentID = unbound->second;
+            ASSERT(m_ComponentPools[componentID]->GetComponentSize() == COMPONENT_SIZE<T> &&
+                       m_ComponentPools[componentID]->GetAlignment() == alignof(T),
+                   "Component layout does not match the loaded world image.");
+
+            m_UnboundComponentMap.erase(unbound);
+            m_ComponentTypeMap[typeIndex] = componentID;
+            if constexpr (IS_SOA<T>) {
+                FieldLayout fields[SoAFields<T>::COUNT];
+                SoAFields<T>::Describe(fields);
+                GetMutableComponentPool(componentID).SetFieldLayout(fields, SoAFields<T>::COUNT);
+            }
+            if constexpr (IS_SHARED<T>) {
+                GetMutableComponentPool(componentID).MakeShared();
+                ReserveGroupScratch();
+            }
+            return componentID;
+        }
+
+        FieldLayout fields[IS_SOA<T> ? SoAFields<T>::COUNT : 1];
+        size_t fieldCount = 0;
+        if constexpr (IS_SOA<T>) {
+            SoAFields<T>::Describe(fields);
+            fieldCount = SoAFields<T>::COUNT;
+        }
+
+        m_ComponentPools.push_back(MakeComponentPool(COMPONENT_SIZE<T>, alignof(T),
+                                                     typeid(T).name(), fields, fieldCount,
+                                                     IS_SHARED<T>));
         ComponentID componentID = static_cast<ComponentID>(m_ComponentPools.size() - 1);
         m_ComponentTypeMap[typeIndex] = componentID;
 
         return componentID;
     }
 
-    bool ValidEntity(EntityID entityID) const {
-        return entityID < m_NextEntityID && entityID != INVALID_ENTITY_ID;
+    /**
+     * @brief Registers both parts of a split component and links their pools.
+     *
+     * @tparam T Either part.
+     */
+    template <typename T>
+    ComponentID RegisterSplitComponent() {
+        using Hot = typename SplitComponent<T>::Hot;
+        using Cold = typename SplitComponent<T>::Cold;
+
+        ComponentID hot = RegisterComponentType<Hot>();
+        ComponentID cold = RegisterComponentType<Cold>();
+        if (hot == INVALID_COMPONENT_ID || cold == INVALID_COMPONENT_ID) {
+            return INVALID_COMPONENT_ID;
+        }
+
+        if (m_SplitLinks.size() < m_ComponentPools.size()) {
+            m_SplitLinks.resize(m_ComponentPools.size());
+        }
+
+        Hot hotDefault {};
+        Cold coldDefault {};
+        size_t offset = m_SplitDefaults.size();
+        m_SplitDefaults.resize(offset + sizeof(Hot) + sizeof(Cold));
+        memcpy(m_SplitDefaults.data() + offset, &hotDefault, sizeof(Hot));
+        memcpy(m_SplitDefaults.data() + offset + sizeof(Hot), &coldDefault, sizeof(Cold));
+
+        m_SplitLinks[hot] = { cold, true, offset };
+        m_SplitLinks[cold] = { hot, false, offset + sizeof(Hot) };
+        ShareSplitIndex(hot);
+
+        return std::is_same_v<T, Hot> ? hot : cold;
     }
 
-    std::string GetEntityName(EntityID entityID) const {
-        for (auto& entity : m_EntityNameMap) {
-            if (entity.second == entityID) {
-                return entity.first;
+    /**
+     * @brief Aligns the cold part of a split component to the hot part, if it does not share
+     * its index yet, and points it at the index of the hot pool.
+     *
+     * @param componentID Either part.
+     */
+    void ShareSplitIndex(ComponentID componentID) {
+        const SplitLink& link = m_SplitLinks[componentID];
+        ComponentID hot = link.hot ? componentID : link.partner;
+        ComponentID cold = link.hot ? link.partner : componentID;
+
+        ComponentPool& coldPool = GetMutableComponentPool(cold);
+        const ComponentPool& hotPool = *m_ComponentPools[hot];
+        if (!coldPool.SharesIndex()) {
+            coldPool.AlignTo(hotPool, m_SplitDefaults.data() + m_SplitLinks[cold].defaultOffset);
+        }
+        coldPool.ShareIndex(&hotPool);
+    }
+
+    /**
+     * @brief Adds both parts of a split component, the cold part first. The part that
+     * `componentID` names is copied from `componentData`, the other gets its default value.
+     * Entities that already got this part along with the other one, e.g. from
+     * `World::CreateEntities` with both parts, only take the value.
+     *
+     * @param added Receives the added component if `count` is 1, may be `nullptr`.
+     * @return `false` if either pool has no room for the components.
+     */
+    bool AddSplitComponents(const EntityID* entityIDs, size_t count, ComponentID componentID,
+                            const void* componentData, void** added) {
+        size_t present = 0;
+        for (size_t i = 0; i < count; i++) {
+            present += m_ComponentPools[componentID]->HasEntity(entityIDs[i]);
+        }
+        if (present > 0) {
+            ASSERT(present == count, "Entity already has this component.");
+            ComponentPool& pool = GetMutableComponentPool(componentID);
+            for (size_t i = 0; i < count; i++) { pool.SetComponent(entityIDs[i], componentData); }
+            if (count == 1 && added != nullptr && !pool.IsSoA()) {
+                *added = pool.GetMutComponent(entityIDs[0]);
+            }
+            return true;
+        }
+
+        const SplitLink& link = m_SplitLinks[componentID];
+        ComponentID hot = link.hot ? componentID : link.partner;
+        ComponentID cold = link.hot ? link.partner : componentID;
+        if (!m_ComponentPools[hot]->HasRoomFor(count) ||
+            !m_ComponentPools[cold]->HasRoomFor(count)) {
+            return false;
+        }
+
+        for (ComponentID part : { cold, hot }) {
+            const void* data = part == componentID
+                                   ? componentData
+                                   : m_SplitDefaults.data() + m_SplitLinks[part].defaultOffset;
+            ComponentPool& pool = GetMutableComponentPool(part);
+            if (count == 1) {
+                void* component = pool.AddComponent(entityIDs[0], data);
+                if (part == componentID && added != nullptr) {
+                    *added = component;
+                }
+            } else {
+                pool.AddComponents(entityIDs, count, data);
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Gives the cold part of every split component its own index again, so that
+     * its pool can be loaded on its own. Undone by `LinkSplitComponents`.
+     */
+    void UnlinkSplitComponents() {
+        for (size_t i = 0; i < m_SplitLinks.size(); i++) {
+            if (m_SplitLinks[i].partner != INVALID_COMPONENT_ID && !m_SplitLinks[i].hot) {
+                GetMutableComponentPool(static_cast<ComponentID>(i)).ShareIndex(nullptr);
+            }
+        }
+    }
+
+    void LinkSplitComponents() {
+        for (size_t i = 0; i < m_SplitLinks.size(); i++) {
+            if (m_SplitLinks[i].partner != INVALID_COMPONENT_ID && !m_SplitLinks[i].hot) {
+                ShareSplitIndex(static_cast<ComponentID>(i));
+            }
+        }
+    }
+
+    /**
+     * @brief Finds a pool by component name, or creates one that is bound to its type later.
+     */
+    ComponentPool& FindOrCreateComponentPool(const std::string& name, size_t size,
+                                             size_t alignment) {
+        for (size_t i = 0; i < m_ComponentPools.size(); i++) {
+            const ComponentPool& pool = *m_ComponentPools[i];
+            if (pool.GetName() == name) {
+                ASSERT(pool.GetComponentSize() == size && pool.GetAlignment() == alignment,
+                       "Component layout does not match the loaded world image.");
+                return GetMutableComponentPool(static_cast<ComponentID>(i));
+            }
+        }
+
+        ASSERT(m_ComponentPools.size() < MAX_COMPONENT_TYPES,
+               "Maximum number of component types reached.");
+
+        m_ComponentPools.push_back(MakeComponentPool(size, alignment, name));
+        ComponentID componentID = static_cast<ComponentID>(m_ComponentPools.size() - 1);
+        m_UnboundComponentMap[MakeString(name)] = componentID;
+
+        return *m_ComponentPools.back();
+    }
+
+    /**
+     * @brief Returns a pool that only this registry references, duplicating it if needed.
+     * This is the copy-on-write point for pools shared between copies of a registry.
+     */
+    ComponentPool& GetMutableComponentPool(ComponentID componentID) {
+        std::shared_ptr<ComponentPool>& pool = m_ComponentPools[componentID];
+        if (pool.use_count() > 1) {
+            pool = std::allocate_shared<ComponentPool>(Allocator<ComponentPool>(m_pResource),
+                                                       *pool);
+
+            // The cold part of a split follows the copy of the hot part's index
+            ComponentID partner = GetSplitPartner(componentID);
+            if (partner != INVALID_COMPONENT_ID && m_SplitLinks[componentID].hot) {
+                GetMutableComponentPool(partner).ShareIndex(pool.get());
+            }
+        }
+
+        return *pool;
+    }
+
+    /**
+     * @brief Sizes the scratch of `View::EachGroup` for a full pool in a fixed-capacity
+     * registry, as its slab never gets memory back.
+     */
+    void ReserveGroupScratch() {
+        if (IsFixedCapacity()) {
+            m_GroupScratch.keys.reserve(m_PoolCapacity);
+            m_GroupScratch.ends.reserve(m_PoolCapacity);
+            m_GroupScratch.entities.reserve(m_PoolCapacity);
+        }
+    }
+
+    /**
+     * @brief Creates a pool whose storage and control block come from the registry's resource.
+     */
+    std::shared_ptr<ComponentPool> MakeComponentPool(size_t size, size_t alignment,
+                                                     const std::string& name,
+                                                     const FieldLayout* fields = nullptr,
+                                                     size_t fieldCount = 0, bool shared = false) {
+        auto pool = std::allocate_shared<ComponentPool>(Allocator<ComponentPool>(m_pResource),
+                                                        size, alignment, name, m_pResource);
+        // SoA and shared before the fixed capacity, so a fixed pool is allocated once at full
+        // size
+        if (fieldCount > 0) {
+            pool->SetFieldLayout(fields, fieldCount);
+        }
+        if (shared) {
+            pool->MakeShared();
+            ReserveGroupScratch();
+        }
+        if (m_PoolCapacity > 0) {
+            pool->MakeFixed(m_PoolCapacity, m_MaxEntities);
+        }
+        pool->SetShrinkPolicy(m_ShrinkPolicy);
+        pool->SetGrowthPolicy(m_GrowthPolicy);
+        return pool;
+    }
+
+    /**
+     * @brief Puts the index of `entityID` on the free list, where it waits to be handed out
+     * again as `entityID`. The record of the index keeps the generation of `entityID` and
+     * the index of the next free record.
+     */
+    void PushFreeEntity(EntityID entityID) {
+        if (m_ReusePolicy == ReusePolicy::Lifo) {
+            EntityID index = Traits::GetIndex(entityID);
+            m_Entities[index] = Traits::MakeID(static_cast<EntityIndex>(m_FreeHead),
+                                               Traits::GetGeneration(entityID));
+            if (m_FreeCount == 0) {
+                m_FreeTail = index;
             }
+            m_FreeHead = index;
+            m_FreeCount++;
+        } else {
+            AppendFreeEntity(entityID);
+        }
+    }
+
+    /**
+     * @brief Puts the index of `entityID` at the end of the free list.
+     */
+    void AppendFreeEntity(EntityID entityID) {
+        EntityID index = Traits::GetIndex(entityID);
+        m_Entities[index] =
+            Traits::MakeID(static_cast<EntityIndex>(NULL_INDEX), Traits::GetGeneration(entityID));
+        if (m_FreeCount == 0) {
+            m_FreeHead = index;
+        } else {
+            SetFreeLink(m_FreeTail, index);
+        }
+        m_FreeTail = index;
+        m_FreeCount++;
+    }
+
+    /**
+     * @brief Takes the first index off the free list and returns its ID.
+     */
+    EntityID PopFreeEntity() {
+        EntityID index = m_FreeHead;
+        EntityID record = m_Entities[index];
+        EntityID entityID =
+            Traits::MakeID(static_cast<EntityIndex>(index), Traits::GetGeneration(record));
+        m_Entities[index] = entityID;
+
+        m_FreeHead = Traits::GetIndex(record);
+        if (--m_FreeCount == 0) {
+            m_FreeHead = NULL_INDEX;
+            m_FreeTail = NULL_INDEX;
+        }
+        return entityID;
+    }
+
+    /**
+     * @brief Takes an index out of the middle of the free list. Walks the list, so it is
+     * only used when another world decides that the entity exists (see `SyncEntity`).
+     */
+    void UnlinkFreeEntity(EntityID index) {
+        EntityID previous = NULL_INDEX;
+        EntityID current = m_FreeHead;
+        while (current != index) {
+            previous = current;
+            current = Traits::GetIndex(m_Entities[current]);
         }
 
-        return "";
+        EntityID next = Traits::GetIndex(m_Entities[index]);
+        if (previous == NULL_INDEX) {
+            m_FreeHead = next;
+        } else {
+            SetFreeLink(previous, next);
+        }
+        if (m_FreeTail == index) {
+            m_FreeTail = previous;
+        }
+        m_FreeCount--;
+    }
+
+    // Points the free record at `index` to the free record at `next`, keeping its generation
+    void SetFreeLink(EntityID index, EntityID next) {
+        m_Entities[index] = Traits::MakeID(static_cast<EntityIndex>(next),
+                                           Traits::GetGeneration(m_Entities[index]));
+    }
+
+    /**
+     * @brief Checks if the record of an index is on the free list. Live records and records
+     * that were never handed out hold their own index.
+     */
+    bool IsFreeRecord(EntityID index) const { return Traits::GetIndex(m_Entities[index]) != index; }
+
+    /**
+     * @brief Adds a record with generation 0 for every new index below `count`.
+     */
+    void GrowEntities(size_t count) {
+        while (m_Entities.size() < count) {
+            m_Entities.push_back(
+                Traits::MakeID(static_cast<EntityIndex>(m_Entities.size()), 0));
+        }
+    }
+
+    /**
+     * @brief Takes over an entity created elsewhere (a world image or the world a delta was
+     * computed on), including its generation. If its index was free here, it leaves the
+     * free list.
+     */
+    void SyncEntity(EntityID entityID) {
+        EntityID index = Traits::GetIndex(entityID);
+        GrowEntities(static_cast<size_t>(index) + 1);
+        if (IsFreeRecord(index)) {
+            UnlinkFreeEntity(index);
+        }
+        m_Entities[index] = entityID;
+    }
+
+    /**
+     * @brief Frees an index like the world a delta was computed on did: the entity living
+     * there is destroyed, and the index comes back with the generation of `freeID`.
+     */
+    void SyncFreeEntity(EntityID freeID) {
+        EntityID index = Traits::GetIndex(freeID);
+        GrowEntities(static_cast<size_t>(index) + 1);
+        if (IsFreeRecord(index)) {
+            UnlinkFreeEntity(index);
+        } else {
+            EntityID entityID = m_Entities[index];
+            for (size_t i = 0; i < m_ComponentPools.size(); i++) {
+                RemoveComponent(entityID, static_cast<ComponentID>(i));
+            }
+            m_Names.Erase(entityID);
+        }
+        PushFreeEntity(freeID);
+    }
+
+    String MakeString(const std::string& string) const {
+        return String(string.data(), string.size(), m_pResource);
     }
 
 private:
-    std::vector<ComponentPool> m_ComponentPools;
-    std::unordered_map<std::type_index, ComponentID> m_ComponentTypeMap;
-    std::unordered_map<std::type_index, void*> m_SingletonComponents;
+    std::pmr::memory_resource* m_pResource = std::pmr::get_default_resource();
+
+    // Keeps mapped pool storage alive. Shared with copies, since they may share mapped pools.
+    std::shared_ptr<FileMapping> m_pImage;
+
+    Vector<std::shared_ptr<ComponentPool>> m_ComponentPools;
+    HashMap<std::type_index, ComponentID> m_ComponentTypeMap;
+
+    SingletonStore m_Singletons;
+
+    NameIndex m_Names;
+
+    // The entity records, by index. A live record holds the ID of its entity, a free one
+    // holds the index of the next free record and the generation the index comes back with.
+    Vector<EntityID> m_Entities;
 
-    // std::vector<EntityID> m_Entities;
-    std::unordered_map<std::string, EntityID> m_EntityNameMap;
-    std::queue<EntityID> m_FreeEntityIDs;
+    // The free list threaded through `m_Entities`, in the order indices are handed out
+    EntityID m_FreeHead = NULL_INDEX;
+    EntityID m_FreeTail = NULL_INDEX;
+    size_t m_FreeCount = 0;
+    ReusePolicy m_ReusePolicy = ReusePolicy::Fifo;
+
+    // Indices with a record, and indices handed out including reservations of other threads.
+    // `FlushReservedEntities` brings the first up to the second.
     EntityID m_NextEntityID = 0;
+    std::atomic<EntityID> m_ReservedEntityID { 0 };
+
+    // Fixed-capacity limits (see `SetFixedCapacity`), a pool capacity of 0 means growable
+    EntityID m_MaxEntities = Traits::INDEX_MASK;
+    size_t m_PoolCapacity = 0;
+
+    // Pools created from a world image whose type has not been requested yet, by type name
+    HashMap<String, ComponentID, StringHash> m_UnboundComponentMap;
+
+    // Reused by the bulk operations so they do not allocate every call
+    Vector<bool> m_DeadScratch;
+    Vector<EntityID> m_EntityScratch;
+    GroupScratch m_GroupScratch;
+
+    // Given to every new pool
+    ShrinkPolicy m_ShrinkPolicy;
+    GrowthPolicy m_GrowthPolicy;
+
+    // Split components (see `SplitComponent`), by ComponentID. The default values of the
+    // parts are kept in `m_SplitDefaults`, for adding one part without the other.
+    struct SplitLink {
+        ComponentID partner = INVALID_COMPONENT_ID;
+        bool hot = false;
+        size_t defaultOffset = 0; // Into `m_SplitDefaults`
+    };
+    Vector<SplitLink> m_SplitLinks;
+    Vector<uint8_t> m_SplitDefaults;
 };
+
+using Registry = BasicRegistry<DefaultIDTraits>;
 } // namespace microECS
\ No newline at end of file
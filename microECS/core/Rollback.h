@@ -0,0 +1,295 @@
+#pragma once
+
+#include "Assert.h"
+#include "ComponentPool.h"
+#include "Memory.h"
+#include "Types.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <utility>
+
+namespace microECS {
+
+/**
+ * @class BasicRollbackBuffer
+ * @brief A ring of saved frames for the pools marked as "rollback".
+ *
+ * Every (pool, slot) pair owns a buffer that is preallocated for the capacity given when the
+ * pool is marked, so saving a frame is a plain memcpy of the dense arrays and never allocates
+ * (unless a pool outgrows the capacity it was marked with).
+ *
+ * A pool whose version did not change since its last save is not copied at all: its slot
+ * refers to the slot holding the data instead. Before such a data slot is reused, its buffer
+ * is handed over to one of the slots that refer to it, so this stays zero-copy as well.
+ *
+ * @note Only component data and membership of the rollback pools is rewound.
+ * Entity IDs created after the restored frame are not returned to the registry.
+ */
+template <typename Traits>
+class BasicRollbackBuffer {
+public:
+    using EntityID = typename Traits::EntityID;
+    using ComponentID = typename Traits::ComponentID;
+    using ComponentPool = BasicComponentPool<Traits>;
+
+    explicit BasicRollbackBuffer(
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : m_pResource(resource), m_Pools(resource), m_SlotFrames(resource) {}
+
+    BasicRollbackBuffer(const BasicRollbackBuffer&) = delete;
+    BasicRollbackBuffer& operator=(const BasicRollbackBuffer&) = delete;
+
+    BasicRollbackBuffer(BasicRollbackBuffer&& other) noexcept
+        : m_pResource(other.m_pResource), m_Pools(std::move(other.m_Pools)),
+          m_SlotFrames(std::move(other.m_SlotFrames)), m_FrameCount(other.m_FrameCount) {
+        other.m_Pools.clear();
+        other.m_FrameCount = 0;
+    }
+
+    BasicRollbackBuffer& operator=(BasicRollbackBuffer&& other) noexcept {
+        std::swap(m_pResource, other.m_pResource);
+        std::swap(m_Pools, other.m_Pools);
+        std::swap(m_SlotFrames, other.m_SlotFrames);
+        std::swap(m_FrameCount, other.m_FrameCount);
+        return *this;
+    }
+
+    ~BasicRollbackBuffer() {
+        for (auto& pool : m_Pools) {
+            for (auto& slot : pool.slots) { Deallocate(pool, slot); }
+        }
+    }
+
+    /**
+     * @brief Sets the number of frames kept in the ring. Clears all saved frames.
+     *
+     * @param frames The number of frames that can be restored.
+     */
+    void Configure(size_t frames) {
+        ASSERT(frames > 0, "Rollback needs at least one frame.");
+
+        m_FrameCount = frames;
+        m_SlotFrames.assign(frames, INVALID_FRAME);
+        for (auto& pool : m_Pools) { AllocateSlots(pool); }
+    }
+
+    /**
+     * @brief Adds a pool to the set of pools that are saved every frame.
+     *
+     * @param componentID The pool to save.
+     * @param pool The pool itself, used for its component layout.
+     * @param capacity The number of components to preallocate per saved frame.
+     */
+    void Track(ComponentID componentID, const ComponentPool& pool, size_t capacity) {
+        for (auto& tracked : m_Pools) {
+            if (tracked.componentID == componentID) {
+                return;
+            }
+        }
+
+        TrackedPool tracked;
+        tracked.componentID = componentID;
+        tracked.componentSize = pool.GetComponentSize();
+        tracked.alignment = pool.GetAlignment();
+        tracked.capacity = capacity > pool.GetCount() ? capacity : pool.GetCount();
+        m_Pools.push_back(std::move(tracked));
+        AllocateSlots(m_Pools.back());
+    }
+
+    /**
+     * @brief Saves the tracked pools as `frame`, replacing the oldest frame in the ring.
+     *
+     * @param frame The frame number. Frames are expected to increase by one per save.
+     * @param getPool Returns the ComponentPool for a ComponentID.
+     */
+    template <typename GetPool>
+    void Save(uint64_t frame, GetPool&& getPool) {
+        ASSERT(m_FrameCount > 0, "Rollback is not configured.");
+
+        size_t slotIndex = static_cast<size_t>(frame % m_FrameCount);
+        m_SlotFrames[slotIndex] = frame;
+
+        for (auto& tracked : m_Pools) {
+            const ComponentPool& pool = getPool(tracked.componentID);
+            Slot& slot = tracked.slots[slotIndex];
+
+            // The slot already holds exactly this data
+            if (slot.source == slotIndex && slot.version == pool.GetVersion() &&
+                tracked.lastSlot == slotIndex) {
+                continue;
+            }
+
+            ReleaseSlot(tracked, slotIndex);
+
+            // Unchanged since the last save: refer to that slot instead of copying
+            if (tracked.lastSlot != INVALID_SLOT &&
+                tracked.slots[tracked.lastSlot].version == pool.GetVersion()) {
+                slot.source = tracked.lastSlot;
+                continue;
+            }
+
+            if (pool.GetCount() > tracked.capacity) {
+                Grow(tracked, pool.GetCount());
+            }
+
+            pool.ReadComponents(slot.data);
+            for (size_t i = 0; i < pool.GetCount(); i++) { slot.entities[i] = pool.GetEntityID(i); }
+            slot.count = pool.GetCount();
+            slot.version = pool.GetVersion();
+            slot.structureVersion = pool.GetStructureVersion();
+            slot.source = slotIndex;
+            tracked.lastSlot = slotIndex;
+        }
+    }
+
+    /**
+     * @brief Restores the tracked pools to their state at `frame`.
+     *
+     * @param frame The frame to restore.
+     * @param getPool Returns the ComponentPool for a ComponentID.
+     * @return `false` if the frame is not (or no longer) in the ring.
+     */
+    template <typename GetPool>
+    bool Restore(uint64_t frame, GetPool&& getPool) {
+        if (!HasFrame(frame)) {
+            return false;
+        }
+
+        size_t slotIndex = static_cast<size_t>(frame % m_FrameCount);
+        for (auto& tracked : m_Pools) {
+            // Pools marked after this frame was saved have nothing to restore
+            size_t source = tracked.slots[slotIndex].source;
+            if (source == INVALID_SLOT) {
+                continue;
+            }
+
+            ComponentPool& pool = getPool(tracked.componentID);
+            const Slot& slot = tracked.slots[source];
+
+            bool restoreEntities = pool.GetStructureVersion() != slot.structureVersion;
+            pool.RestoreComponents(slot.data, slot.entities.data(), slot.count, restoreEntities);
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Checks if `frame` can still be restored.
+     */
+    bool HasFrame(uint64_t frame) const {
+        return m_FrameCount > 0 && m_SlotFrames[static_cast<size_t>(frame % m_FrameCount)] == frame;
+    }
+
+    size_t GetFrameCount() const { return m_FrameCount; }
+
+private:
+    static constexpr size_t INVALID_SLOT = static_cast<size_t>(-1);
+    static constexpr uint64_t INVALID_FRAME = static_cast<uint64_t>(-1);
+
+    struct Slot {
+        void* data = nullptr;
+        Vector<EntityID> entities;
+        size_t count = 0;
+        uint64_t version = 0;
+        uint64_t structureVersion = 0;
+        size_t source = INVALID_SLOT; // The slot whose buffer holds this frame's data
+    };
+
+    struct TrackedPool {
+        ComponentID componentID = Traits::INVALID_COMPONENT_ID;
+        size_t componentSize = 0;
+        size_t alignment = 0;
+        size_t capacity = 0;
+        size_t lastSlot = INVALID_SLOT;
+        Vector<Slot> slots;
+    };
+
+    /**
+     * @brief Hands the buffer of `slotIndex` to the slots that still refer to it,
+     * so the slot can be overwritten.
+     */
+    void ReleaseSlot(TrackedPool& tracked, size_t slotIndex) {
+        if (tracked.lastSlot == slotIndex) {
+            tracked.lastSlot = INVALID_SLOT;
+        }
+
+        if (tracked.slots[slotIndex].source != slotIndex) {
+            return;
+        }
+
+        size_t heir = INVALID_SLOT;
+        for (size_t i = 0; i < tracked.slots.size(); i++) {
+            Slot& slot = tracked.slots[i];
+            if (i == slotIndex || slot.source != slotIndex) {
+                continue;
+            }
+
+            if (heir == INVALID_SLOT) {
+                // Swap buffers: the referring slot takes the data, its unused buffer comes back
+                heir = i;
+                Slot& owner = tracked.slots[slotIndex];
+                std::swap(slot.data, owner.data);
+                std::swap(slot.entities, owner.entities);
+                slot.count = owner.count;
+                slot.version = owner.version;
+                slot.structureVersion = owner.structureVersion;
+            }
+            slot.source = heir;
+        }
+
+        if (heir != INVALID_SLOT && tracked.lastSlot == INVALID_SLOT) {
+            tracked.lastSlot = heir;
+        }
+        tracked.slots[slotIndex].source = INVALID_SLOT;
+    }
+
+    void AllocateSlots(TrackedPool& tracked) {
+        for (auto& slot : tracked.slots) { Deallocate(tracked, slot); }
+
+        tracked.slots = Vector<Slot>(m_FrameCount, Slot(), m_pResource);
+        tracked.lastSlot = INVALID_SLOT;
+        for (auto& slot : tracked.slots) {
+            slot.data = m_pResource->allocate(tracked.componentSize * tracked.capacity,
+                                              tracked.alignment);
+            slot.entities = Vector<EntityID>(tracked.capacity, m_pResource);
+        }
+    }
+
+    /**
+     * @brief Grows every buffer of a pool that outgrew its reserved capacity.
+     * This is the only place where saving allocates.
+     */
+    void Grow(TrackedPool& tracked, size_t count) {
+        size_t capacity = tracked.capacity * 2 > count ? tracked.capacity * 2 : count;
+        for (auto& slot : tracked.slots) {
+            void* data = m_pResource->allocate(tracked.componentSize * capacity, tracked.alignment);
+            if (slot.source != INVALID_SLOT) {
+                std::memcpy(data, slot.data, slot.count * tracked.componentSize);
+            }
+            Deallocate(tracked, slot);
+            slot.data = data;
+            slot.entities.resize(capacity);
+        }
+        tracked.capacity = capacity;
+    }
+
+    void Deallocate(const TrackedPool& tracked, Slot& slot) {
+        if (slot.data != nullptr) {
+            m_pResource->deallocate(slot.data, tracked.componentSize * tracked.capacity,
+                                    tracked.alignment);
+            slot.data = nullptr;
+        }
+    }
+
+private:
+    std::pmr::memory_resource* m_pResource;
+    Vector<TrackedPool> m_Pools;
+    Vector<uint64_t> m_SlotFrames;
+    size_t m_FrameCount = 0;
+};
+
+using RollbackBuffer = BasicRollbackBuffer<DefaultIDTraits>;
+
+} // namespace microECS
@@ -0,0 +1,331 @@
+#pragma once
+
+#include "Assert.h"
+#include "Memory.h"
+#include "NameIndex.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <utility>
+
+namespace microECS {
+
+// Index of a value in a `SharedValueStore`, kept per entity by the pool of a shared component
+using SharedIndex = uint32_t;
+
+/**
+ * @class SharedValueStore
+ * @brief Holds one copy of every distinct value of a shared component (see
+ * `SharedComponent`), together with the number of entities that reference it.
+ *
+ * Values are found by an FNV-1a hash of their bytes and compared with memcmp, so two values
+ * that only differ in their padding are kept apart. A value is dropped when its last
+ * reference is released, and its slot is reused by the next new value. All bookkeeping is
+ * kept in arrays that only grow with the number of values, so a store whose values come and
+ * go does not allocate.
+ *
+ * @warning Adding a new value may move the block, which invalidates pointers to the values.
+ */
+class SharedValueStore {
+public:
+    static constexpr SharedIndex INVALID_INDEX = UINT32_MAX;
+
+    SharedValueStore(size_t size, size_t alignment,
+                     std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : m_pResource(resource), m_Size(size), m_Alignment(alignment),
+          m_Stride((size + alignment - 1) & ~(alignment - 1)), m_References(resource),
+          m_Hashes(resource), m_Next(resource), m_Buckets(resource), m_Scratch(resource) {}
+
+    /**
+     * @brief Deep-copies the store. The copy allocates from the same memory resource.
+     */
+    SharedValueStore(const SharedValueStore& other)
+        : m_pResource(other.m_pResource), m_Size(other.m_Size), m_Alignment(other.m_Alignment),
+          m_Stride(other.m_Stride), m_Capacity(other.m_Capacity),
+          m_ValueCount(other.m_ValueCount), m_FreeHead(other.m_FreeHead),
+          m_References(other.m_References), m_Hashes(other.m_Hashes), m_Next(other.m_Next),
+          m_Buckets(other.m_Buckets), m_Scratch(other.m_pResource) {
+        if (m_Capacity > 0) {
+            m_pData = static_cast<uint8_t*>(
+                m_pResource->allocate(m_Capacity * m_Stride, m_Alignment));
+            memcpy(m_pData, other.m_pData, m_References.size() * m_Stride);
+        }
+    }
+
+    SharedValueStore(SharedValueStore&& other) noexcept
+        : SharedValueStore(other.m_Size, other.m_Alignment, other.m_pResource) {
+        Swap(other);
+    }
+
+    SharedValueStore& operator=(SharedValueStore other) noexcept {
+        Swap(other);
+        return *this;
+    }
+
+    ~SharedValueStore() {
+        if (m_pData != nullptr) {
+            m_pResource->deallocate(m_pData, m_Capacity * m_Stride, m_Alignment);
+        }
+    }
+
+    /**
+     * @brief Adds `references` references to `value`, storing a copy of it if it is new.
+     *
+     * @param value The value, `size` bytes as given to the constructor.
+     * @param references The number of entities that start referencing the value.
+     * @return The index of the stored value.
+     */
+    SharedIndex Acquire(const void* value, size_t references = 1) {
+        uint64_t hash = HashName(static_cast<const char*>(value), m_Size);
+        if (!m_Buckets.empty()) {
+            for (SharedIndex index = m_Buckets[Bucket(hash)]; index != INVALID_INDEX;
+                 index = m_Next[index]) {
+                if (m_Hashes[index] == hash && memcmp(Get(index), value, m_Size) == 0) {
+                    m_References[index] += references;
+                    return index;
+                }
+            }
+        }
+
+        SharedIndex index = m_FreeHead;
+        if (index != INVALID_INDEX) {
+            m_FreeHead = m_Next[index];
+        } else {
+            index = static_cast<SharedIndex>(m_References.size());
+            ASSERT(index != INVALID_INDEX, "Too many distinct shared values.");
+            if (index == m_Capacity) {
+                Grow(m_Capacity > 0 ? m_Capacity * 2 : 16);
+            }
+            m_References.push_back(0);
+            m_Hashes.push_back(0);
+            m_Next.push_back(INVALID_INDEX);
+        }
+        if (m_References.size() > m_Buckets.size()) {
+            Rehash(m_Buckets.empty() ? 16 : m_Buckets.size() * 2);
+        }
+
+        memcpy(m_pData + index * m_Stride, value, m_Size);
+        m_References[index] = references;
+        m_Hashes[index] = hash;
+        SharedIndex& head = m_Buckets[Bucket(hash)];
+        m_Next[index] = head;
+        head = index;
+        m_ValueCount++;
+        return index;
+    }
+
+    /**
+     * @brief Makes room for `count` distinct values, so acquiring up to that many allocates
+     * nothing.
+     */
+    void Reserve(size_t count) {
+        if (count > m_Capacity) {
+            Grow(count);
+        }
+        m_References.reserve(count);
+        m_Hashes.reserve(count);
+        m_Next.reserve(count);
+        m_Scratch.reserve(m_Size);
+
+        size_t buckets = 16;
+        while (buckets < count) { buckets *= 2; }
+        if (buckets > m_Buckets.size()) {
+            Rehash(buckets);
+        }
+    }
+
+    /**
+     * @brief Adds a reference to a copy of the value at `index` with `length` bytes at
+     * `offset` replaced by `data`. The value at `index` itself is left as it is.
+     *
+     * @return The index of the stored value.
+     */
+    SharedIndex AcquirePatched(SharedIndex index, size_t offset, const void* data,
+                               size_t length) {
+        ASSERT(offset + length <= m_Size, "Patch is out of the value.");
+        // Acquiring may move the values, so the patched value is built on the side
+        m_Scratch.resize(m_Size);
+        memcpy(m_Scratch.data(), Get(index), m_Size);
+        memcpy(m_Scratch.data() + offset, data, length);
+        return Acquire(m_Scratch.data());
+    }
+
+    /**
+     * @brief Drops one reference to a value, and the value itself with its last reference.
+     */
+    void Release(SharedIndex index) {
+        ASSERT(index < m_References.size() && m_References[index] > 0,
+               "Shared value is not referenced.");
+        if (--m_References[index] > 0) {
+            return;
+        }
+
+        // Unlink the value from the values in its bucket
+        SharedIndex* link = &m_Buckets[Bucket(m_Hashes[index])];
+        while (*link != index) { link = &m_Next[*link]; }
+        *link = m_Next[index];
+
+        m_Next[index] = m_FreeHead;
+        m_FreeHead = index;
+        m_ValueCount--;
+    }
+
+    /**
+     * @brief Returns the value at `index`, which must be referenced.
+     */
+    const void* Get(SharedIndex index) const { return m_pData + index * m_Stride; }
+
+    /**
+     * @brief Returns the number of entities that reference the value at `index`,
+     * 0 for a free slot.
+     */
+    size_t GetReferenceCount(SharedIndex index) const {
+        return index < m_References.size() ? m_References[index] : 0;
+    }
+
+    /**
+     * @brief Returns the number of distinct values in the store.
+     */
+    size_t GetValueCount() const { return m_ValueCount; }
+
+    /**
+     * @brief Returns one past the largest index in use; free slots below it are unreferenced.
+     */
+    size_t GetSlotCount() const { return m_References.size(); }
+
+    /**
+     * @brief Returns the bytes owned by the store: the values and their bookkeeping.
+     */
+    size_t GetMemoryUsage() const {
+        size_t perSlot = sizeof(size_t) + sizeof(uint64_t) + sizeof(SharedIndex);
+        return m_Capacity * m_Stride + m_References.capacity() * perSlot +
+               m_Buckets.capacity() * sizeof(SharedIndex) + m_Scratch.capacity();
+    }
+
+    /**
+     * @brief Drops every value. The block and the buckets are kept for reuse.
+     */
+    void Clear() {
+        m_References.clear();
+        m_Hashes.clear();
+        m_Next.clear();
+        m_Buckets.assign(m_Buckets.size(), INVALID_INDEX);
+        m_FreeHead = INVALID_INDEX;
+        m_ValueCount = 0;
+    }
+
+    void Swap(SharedValueStore& other) noexcept {
+        std::swap(m_pResource, other.m_pResource);
+        std::swap(m_pData, other.m_pData);
+        std::swap(m_Size, other.m_Size);
+        std::swap(m_Alignment, other.m_Alignment);
+        std::swap(m_Stride, other.m_Stride);
+        std::swap(m_Capacity, other.m_Capacity);
+        std::swap(m_ValueCount, other.m_ValueCount);
+        std::swap(m_FreeHead, other.m_FreeHead);
+        std::swap(m_References, other.m_References);
+        std::swap(m_Hashes, other.m_Hashes);
+        std::swap(m_Next, other.m_Next);
+        std::swap(m_Buckets, other.m_Buckets);
+        std::swap(m_Scratch, other.m_Scratch);
+    }
+
+private:
+    /**
+     * @brief Moves the values to a block with room for `capacity` values, at the same indices.
+     */
+    void Grow(size_t capacity) {
+        uint8_t* data = static_cast<uint8_t*>(m_pResource->allocate(capacity * m_Stride,
+                                                                    m_Alignment));
+        if (m_pData != nullptr) {
+            memcpy(data, m_pData, m_References.size() * m_Stride);
+            m_pResource->deallocate(m_pData, m_Capacity * m_Stride, m_Alignment);
+        }
+
+        m_pData = data;
+        m_Capacity = capacity;
+    }
+
+    /**
+     * @brief Spreads the values over `count` buckets, a power of two.
+     */
+    void Rehash(size_t count) {
+        m_Buckets.assign(count, INVALID_INDEX);
+        for (SharedIndex index = 0; index < m_References.size(); index++) {
+            if (m_References[index] > 0) {
+                SharedIndex& head = m_Buckets[Bucket(m_Hashes[index])];
+                m_Next[index] = head;
+                head = index;
+            }
+        }
+    }
+
+    size_t Bucket(uint64_t hash) const {
+        return static_cast<size_t>(hash) & (m_Buckets.size() - 1);
+    }
+
+private:
+    std::pmr::memory_resource* m_pResource;
+
+    // The values, `m_Stride` bytes apart
+    uint8_t* m_pData = nullptr;
+    size_t m_Size;
+    size_t m_Alignment;
+    size_t m_Stride;
+    size_t m_Capacity = 0;
+
+    size_t m_ValueCount = 0;
+    SharedIndex m_FreeHead = INVALID_INDEX;
+
+    // Indexed by SharedIndex. `m_Next` links values in the same bucket, or free slots.
+    Vector<size_t> m_References;
+    Vector<uint64_t> m_Hashes;
+    Vector<SharedIndex> m_Next;
+
+    // The first value of every bucket, at least one bucket per slot
+    Vector<SharedIndex> m_Buckets;
+
+    // Where `AcquirePatched` builds its value
+    Vector<uint8_t> m_Scratch;
+};
+
+/**
+ * @brief Opts a component type into shared storage: its pool keeps one copy of every distinct
+ * value, and each entity only a `SharedIndex` into those values. Meant for components that
+ * thousands of entities hold with the same few values, like materials or AI settings.
+ * Specialize it with `ENABLED = true`, or use `MECS_SHARED` at global scope:
+ *
+ * @code
+ * struct MaterialParams { float albedo[4]; float roughness; uint32_t shader; };
+ * MECS_SHARED(MaterialParams);
+ *
+ * world.View<MaterialParams>().EachGroup(
+ *     [](const MaterialParams& material, const microECS::EntityID* entities, size_t count) {
+ *         BindMaterial(material);
+ *         DrawInstances(entities, count);
+ *     });
+ * @endcode
+ *
+ * Shared values are immutable in place: views hand out a `const T&`, `Entity::Get` returns a
+ * `const T*`, and a new value is set with `Entity::Set`. Shared components cannot be sorted,
+ * exported as a column, stored as SoA or split.
+ */
+template <typename T>
+struct SharedComponent {
+    static constexpr bool ENABLED = false;
+};
+
+template <typename T>
+constexpr bool IS_SHARED = SharedComponent<T>::ENABLED;
+
+} // namespace microECS
+
+// `MECS_SHARED(Type)` declares a shared component, see `SharedComponent`.
+// Must be used at global scope.
+#define MECS_SHARED(Type)                                                                       \
+    template <>                                                                                 \
+    struct microECS::SharedComponent<Type> {                                                    \
+        static constexpr bool ENABLED = true;                                                   \
+    }
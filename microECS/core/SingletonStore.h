@@ -0,0 +1,194 @@
+#pragma once
+
+#include "Assert.h"
+#include "Memory.h"
+#include "Types.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <utility>
+
+namespace microECS {
+
+/**
+ * @class SingletonStore
+ * @brief Holds the singleton components of a registry in one contiguous, cache-aligned block.
+ *
+ * Every singleton type gets a small integer ID the first time it is used (see `TypeID`), and
+ * the store keeps a table of data pointers indexed by that ID, so a lookup is a bounds check
+ * and one array load instead of a hash map lookup.
+ *
+ * @note Singletons are copied with memcpy, like components.
+ * @warning Setting a singleton of a new type may move the block, which invalidates pointers
+ * to the other singletons. Overwriting an existing singleton never does.
+ */
+class SingletonStore {
+public:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    explicit SingletonStore(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : m_pResource(resource), m_Offsets(resource), m_Pointers(resource) {}
+
+    /**
+     * @brief Deep-copies the store. The copy allocates from the same memory resource.
+     */
+    SingletonStore(const SingletonStore& other)
+        : m_pResource(other.m_pResource), m_Size(other.m_Size), m_Capacity(other.m_Capacity),
+          m_Alignment(other.m_Alignment), m_Count(other.m_Count), m_Offsets(other.m_Offsets),
+          m_Pointers(other.m_pResource) {
+        if (m_Capacity > 0) {
+            m_pData = static_cast<uint8_t*>(m_pResource->allocate(m_Capacity, m_Alignment));
+            memcpy(m_pData, other.m_pData, m_Size);
+        }
+        UpdatePointers();
+    }
+
+    SingletonStore(SingletonStore&& other) noexcept : SingletonStore(other.m_pResource) {
+        Swap(other);
+    }
+
+    SingletonStore& operator=(SingletonStore other) noexcept {
+        Swap(other);
+        return *this;
+    }
+
+    ~SingletonStore() {
+        if (m_pData != nullptr) {
+            m_pResource->deallocate(m_pData, m_Capacity, m_Alignment);
+        }
+    }
+
+    /**
+     * @brief Returns the ID of a singleton type, assigned the first time the type is used.
+     * IDs are shared by every store of the process and stay small and dense.
+     *
+     * @tparam T The singleton type.
+     */
+    template <typename T>
+    static size_t TypeID() {
+        static const size_t typeID = NextTypeID();
+        return typeID;
+    }
+
+    /**
+     * @brief Sets the singleton with the given type ID, overwriting its previous value.
+     *
+     * @param typeID The ID of the singleton type, see `TypeID`.
+     * @param data The value to copy.
+     * @param size The size of the singleton type.
+     * @param alignment The alignment of the singleton type.
+     * @return A pointer to the stored singleton.
+     */
+    void* Set(size_t typeID, const void* data, size_t size, size_t alignment) {
+        void* existing = Get(typeID);
+        if (existing != nullptr) {
+            memcpy(existing, data, size);
+            return existing;
+        }
+
+        ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0,
+               "Alignment must be a power of two.");
+
+        size_t offset = (m_Size + alignment - 1) & ~(alignment - 1);
+        if (offset + size > m_Capacity || alignment > m_Alignment) {
+            Grow(offset + size, alignment);
+        }
+
+        if (typeID >= m_Offsets.size()) {
+            m_Offsets.resize(typeID + 1, INVALID_OFFSET);
+        }
+        m_Offsets[typeID] = offset;
+        m_Size = offset + size;
+        m_Count++;
+
+        memcpy(m_pData + offset, data, size);
+        UpdatePointers();
+        return m_pData + offset;
+    }
+
+    /**
+     * @brief Returns the singleton with the given type ID, or nullptr if it was never set.
+     */
+    void* Get(size_t typeID) const {
+        return typeID < m_Pointers.size() ? m_Pointers[typeID] : nullptr;
+    }
+
+    /**
+     * @brief Returns the number of singletons in the store.
+     */
+    size_t GetCount() const { return m_Count; }
+
+    /**
+     * @brief Returns the size of the block that holds the singletons.
+     */
+    size_t GetCapacity() const { return m_Capacity; }
+
+    std::pmr::memory_resource* GetMemoryResource() const { return m_pResource; }
+
+    void Swap(SingletonStore& other) noexcept {
+        std::swap(m_pResource, other.m_pResource);
+        std::swap(m_pData, other.m_pData);
+        std::swap(m_Size, other.m_Size);
+        std::swap(m_Capacity, other.m_Capacity);
+        std::swap(m_Alignment, other.m_Alignment);
+        std::swap(m_Count, other.m_Count);
+        std::swap(m_Offsets, other.m_Offsets);
+        std::swap(m_Pointers, other.m_Pointers);
+    }
+
+private:
+    static constexpr size_t INVALID_OFFSET = SIZE_MAX;
+
+    static size_t NextTypeID() {
+        static std::atomic<size_t> nextTypeID { 0 };
+        return nextTypeID.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Moves the singletons to a larger block, at the same offsets.
+     */
+    void Grow(size_t size, size_t alignment) {
+        size_t capacity = m_Capacity * 2 > CACHE_LINE_SIZE ? m_Capacity * 2 : CACHE_LINE_SIZE;
+        capacity = capacity > size ? capacity : size;
+        capacity = (capacity + CACHE_LINE_SIZE - 1) & ~(CACHE_LINE_SIZE - 1);
+        size_t newAlignment = alignment > m_Alignment ? alignment : m_Alignment;
+
+        uint8_t* data = static_cast<uint8_t*>(m_pResource->allocate(capacity, newAlignment));
+        if (m_pData != nullptr) {
+            memcpy(data, m_pData, m_Size);
+            m_pResource->deallocate(m_pData, m_Capacity, m_Alignment);
+        }
+
+        m_pData = data;
+        m_Capacity = capacity;
+        m_Alignment = newAlignment;
+    }
+
+    void UpdatePointers() {
+        m_Pointers.assign(m_Offsets.size(), nullptr);
+        for (size_t i = 0; i < m_Offsets.size(); i++) {
+            if (m_Offsets[i] != INVALID_OFFSET) {
+                m_Pointers[i] = m_pData + m_Offsets[i];
+            }
+        }
+    }
+
+private:
+    std::pmr::memory_resource* m_pResource;
+
+    // The block, and how much of it is used
+    uint8_t* m_pData = nullptr;
+    size_t m_Size = 0;
+    size_t m_Capacity = 0;
+    size_t m_Alignment = CACHE_LINE_SIZE;
+    size_t m_Count = 0;
+
+    // Indexed by type ID: the offset of each singleton in the block, and its address
+    Vector<size_t> m_Offsets;
+    Vector<void*> m_Pointers;
+};
+
+} // namespace microECS
@@ -0,0 +1,420 @@
+#pragma once
+
+#include "Assert.h"
+#include "ComponentPool.h"
+#include "Types.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace microECS {
+
+/**
+ * @brief A copy of one component pool: its dense entity array and component bytes.
+ */
+template <typename Traits>
+struct BasicPoolSnapshot {
+    using EntityID = typename Traits::EntityID;
+
+    std::string name;
+    size_t componentSize = 0;
+    size_t alignment = 0;
+    std::vector<EntityID> entities;
+    std::vector<uint8_t> data;
+};
+
+/**
+ * @brief A copy of the component state of a World, used as the base of a delta.
+ * Pools are stored in ComponentID order.
+ */
+template <typename Traits>
+struct BasicWorldSnapshot {
+    typename Traits::EntityID nextEntityID = 0;
+    std::vector<typename Traits::EntityID> freeEntities; // The free list, in reuse order
+    std::vector<BasicPoolSnapshot<Traits>> pools;
+};
+
+/**
+ * @brief A run of changed bytes inside one component.
+ * The new bytes are stored in `PoolDelta::rangeData` at `dataOffset`.
+ */
+template <typename Traits>
+struct BasicByteRange {
+    typename Traits::EntityID entityID;
+    uint32_t offset;
+    uint32_t length;
+    uint32_t dataOffset;
+};
+
+/**
+ * @brief The change set of a single pool between two world states.
+ */
+template <typename Traits>
+struct BasicPoolDelta {
+    using EntityID = typename Traits::EntityID;
+    using ByteRange = BasicByteRange<Traits>;
+
+    std::string name;
+    size_t componentSize = 0;
+    size_t alignment = 0;
+
+    std::vector<EntityID> removed;
+    std::vector<EntityID> added;
+    std::vector<uint8_t> addedData; // `componentSize` bytes per added entity
+    std::vector<ByteRange> modified;
+    std::vector<uint8_t> rangeData;
+
+    bool Empty() const { return removed.empty() && added.empty() && modified.empty(); }
+};
+
+/**
+ * @brief The changes needed to bring a World from a snapshot to its current state.
+ * Pools without changes are omitted. Entities are created and destroyed like on the world
+ * the delta was computed on, so both hand out the same IDs afterwards.
+ */
+template <typename Traits>
+struct BasicWorldDelta {
+    using EntityID = typename Traits::EntityID;
+    using ByteRange = BasicByteRange<Traits>;
+    using PoolDelta = BasicPoolDelta<Traits>;
+
+    EntityID nextEntityID = 0;
+
+    // Entities whose index was free in the snapshot and is live now
+    std::vector<EntityID> created;
+
+    // New free list entries, in free list order, with the generation their index comes back
+    // with. Whatever lives at their index is destroyed.
+    std::vector<EntityID> destroyed;
+
+    std::vector<PoolDelta> pools;
+
+    /**
+     * @brief Checks if the delta changes nothing.
+     */
+    bool Empty() const { return created.empty() && destroyed.empty() && pools.empty(); }
+
+    /**
+     * @brief Writes the delta into a compact byte stream.
+     * Counts, entity IDs and offsets are written as LEB128 varints.
+     *
+     * @param out The buffer to append to.
+     */
+    void Serialize(std::vector<uint8_t>& out) const {
+        WriteVarint(out, nextEntityID);
+        WriteVarint(out, created.size());
+        for (EntityID entityID : created) { WriteVarint(out, entityID); }
+        WriteVarint(out, destroyed.size());
+        for (EntityID entityID : destroyed) { WriteVarint(out, entityID); }
+        WriteVarint(out, pools.size());
+
+        for (const PoolDelta& pool : pools) {
+            WriteVarint(out, pool.name.size());
+            out.insert(out.end(), pool.name.begin(), pool.name.end());
+            WriteVarint(out, pool.componentSize);
+            WriteVarint(out, pool.alignment);
+
+            WriteVarint(out, pool.removed.size());
+            for (EntityID entityID : pool.removed) { WriteVarint(out, entityID); }
+
+            WriteVarint(out, pool.added.size());
+            for (EntityID entityID : pool.added) { WriteVarint(out, entityID); }
+            out.insert(out.end(), pool.addedData.begin(), pool.addedData.end());
+
+            WriteVarint(out, pool.modified.size());
+            for (const ByteRange& range : pool.modified) {
+                WriteVarint(out, range.entityID);
+                WriteVarint(out, range.offset);
+                WriteVarint(out, range.length);
+                out.insert(out.end(), pool.rangeData.begin() + range.dataOffset,
+                           pool.rangeData.begin() + range.dataOffset + range.length);
+            }
+        }
+    }
+
+    /**
+     * @brief Reads a delta written by `Serialize`.
+     *
+     * @param data The serialized delta.
+     * @param size The number of bytes at `data`.
+     * @return `true` on success, `false` if the stream is truncated or malformed.
+     */
+    bool Deserialize(const uint8_t* data, size_t size) {
+        size_t cursor = 0;
+        uint64_t value = 0;
+        auto read = [&](uint64_t& out) { return ReadVarint(data, size, cursor, out); };
+        auto readBytes = [&](std::vector<uint8_t>& out, uint64_t count) {
+            if (count > size - cursor) {
+                return false;
+            }
+            out.insert(out.end(), data + cursor, data + cursor + count);
+            cursor += static_cast<size_t>(count);
+            return true;
+        };
+
+        auto readIDs = [&](std::vector<EntityID>& out) {
+            if (!read(value) || value > size) {
+                return false;
+            }
+            out.resize(static_cast<size_t>(value));
+            for (EntityID& entityID : out) {
+                if (!read(value)) {
+                    return false;
+                }
+                entityID = static_cast<EntityID>(value);
+            }
+            return true;
+        };
+
+        created.clear();
+        destroyed.clear();
+        pools.clear();
+        if (!read(value)) {
+            return false;
+        }
+        nextEntityID = static_cast<EntityID>(value);
+        if (!readIDs(created) || !readIDs(destroyed)) {
+            return false;
+        }
+
+        uint64_t poolCount = 0;
+        if (!read(poolCount)) {
+            return false;
+        }
+
+        for (uint64_t i = 0; i < poolCount; i++) {
+            PoolDelta pool;
+            std::vector<uint8_t> name;
+            uint64_t componentSize = 0, alignment = 0;
+            if (!read(value) || !readBytes(name, value) || !read(componentSize) ||
+                !read(alignment)) {
+                return false;
+            }
+            pool.name.assign(name.begin(), name.end());
+            pool.componentSize = static_cast<size_t>(componentSize);
+            pool.alignment = static_cast<size_t>(alignment);
+
+            if (!read(value) || value > size) {
+                return false;
+            }
+            pool.removed.resize(static_cast<size_t>(value));
+            for (EntityID& entityID : pool.removed) {
+                if (!read(value)) {
+                    return false;
+                }
+                entityID = static_cast<EntityID>(value);
+            }
+
+            if (!read(value) || value > size) {
+                return false;
+            }
+            pool.added.resize(static_cast<size_t>(value));
+            for (EntityID& entityID : pool.added) {
+                if (!read(value)) {
+                    return false;
+                }
+                entityID = static_cast<EntityID>(value);
+            }
+            if (!readBytes(pool.addedData, pool.added.size() * componentSize)) {
+                return false;
+            }
+
+            if (!read(value) || value > size) {
+                return false;
+            }
+            pool.modified.resize(static_cast<size_t>(value));
+            for (ByteRange& range : pool.modified) {
+                uint64_t entityID = 0, offset = 0, length = 0;
+                if (!read(entityID) || !read(offset) || !read(length) ||
+                    offset + length > componentSize) {
+                    return false;
+                }
+                range = { static_cast<EntityID>(entityID), static_cast<uint32_t>(offset),
+                          static_cast<uint32_t>(length),
+                          static_cast<uint32_t>(pool.rangeData.size()) };
+                if (!readBytes(pool.rangeData, length)) {
+                    return false;
+                }
+            }
+
+            pools.push_back(std::move(pool));
+        }
+
+        return cursor == size;
+    }
+
+private:
+    static void WriteVarint(std::vector<uint8_t>& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    static bool ReadVarint(const uint8_t* data, size_t size, size_t& cursor, uint64_t& out) {
+        out = 0;
+        for (int shift = 0; shift < 64 && cursor < size; shift += 7) {
+            uint8_t byte = data[cursor++];
+            out |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+using PoolSnapshot = BasicPoolSnapshot<DefaultIDTraits>;
+using WorldSnapshot = BasicWorldSnapshot<DefaultIDTraits>;
+using ByteRange = BasicByteRange<DefaultIDTraits>;
+using PoolDelta = BasicPoolDelta<DefaultIDTraits>;
+using WorldDelta = BasicWorldDelta<DefaultIDTraits>;
+
+/**
+ * @brief Copies a pool into a snapshot.
+ */
+template <typename Traits>
+void SnapshotPool(const BasicComponentPool<Traits>& pool, BasicPoolSnapshot<Traits>& out) {
+    out.name = pool.GetName();
+    out.componentSize = pool.GetComponentSize();
+    out.alignment = pool.GetAlignment();
+    out.entities.resize(pool.GetCount());
+    for (size_t i = 0; i < pool.GetCount(); i++) { out.entities[i] = pool.GetEntityID(i); }
+
+    out.data.resize(pool.GetCount() * pool.GetComponentSize());
+    pool.ReadComponents(out.data.data());
+}
+
+/**
+ * @brief Appends the byte ranges that differ between two components of `size` bytes.
+ * Components are compared one 64-bit word at a time with XOR, and adjacent changed
+ * words are merged into one range.
+ */
+template <typename Traits>
+void DiffComponent(typename Traits::EntityID entityID, const uint8_t* previous,
+                   const uint8_t* current, size_t size, BasicPoolDelta<Traits>& out) {
+    size_t runStart = 0;
+    bool inRun = false;
+
+    auto closeRun = [&](size_t end) {
+        BasicByteRange<Traits> range = { entityID, static_cast<uint32_t>(runStart),
+                                         static_cast<uint32_t>(end - runStart),
+                                         static_cast<uint32_t>(out.rangeData.size()) };
+        out.rangeData.insert(out.rangeData.end(), current + runStart, current + end);
+        out.modified.push_back(range);
+        inRun = false;
+    };
+
+    for (size_t offset = 0; offset < size; offset += sizeof(uint64_t)) {
+        size_t width = size - offset < sizeof(uint64_t) ? size - offset : sizeof(uint64_t);
+
+        // memcpy keeps the word loads legal for any component alignment
+        uint64_t a = 0, b = 0;
+        std::memcpy(&a, previous + offset, width);
+        std::memcpy(&b, current + offset, width);
+
+        if ((a ^ b) != 0) {
+            if (!inRun) {
+                runStart = offset;
+                inRun = true;
+            }
+        } else if (inRun) {
+            closeRun(offset);
+        }
+    }
+
+    if (inRun) {
+        closeRun(size);
+    }
+}
+
+/**
+ * @brief Computes the change set of one pool against its snapshot.
+ * Only reads from `pool` and `previous`, so different pools can be diffed in parallel.
+ *
+ * @param pool The current state of the pool.
+ * @param previous The snapshot of the same pool, or `nullptr` if the pool did not exist yet.
+ * @param out The change set to fill.
+ */
+template <typename Traits>
+void DiffPool(const BasicComponentPool<Traits>& pool, const BasicPoolSnapshot<Traits>* previous,
+              BasicPoolDelta<Traits>& out) {
+    using EntityID = typename Traits::EntityID;
+
+    size_t size = pool.GetComponentSize();
+    size_t count = pool.GetCount();
+    const uint8_t* current = static_cast<const uint8_t*>(pool.Data());
+
+    // SoA and shared pools are compared as packed components
+    std::vector<uint8_t> gathered;
+    if (!pool.IsPacked()) {
+        gathered.resize(count * size);
+        pool.ReadComponents(gathered.data());
+        current = gathered.data();
+    }
+
+    out.name = pool.GetName();
+    out.componentSize = size;
+    out.alignment = pool.GetAlignment();
+
+    if (previous == nullptr) {
+        out.added.resize(count);
+        for (size_t i = 0; i < count; i++) { out.added[i] = pool.GetEntityID(i); }
+        out.addedData.assign(current, current + count * size);
+        return;
+    }
+
+    ASSERT(previous->componentSize == size, "Snapshot does not match the component pool.");
+
+    // Dense indices of the previous snapshot, only built if the dense order changed
+    std::unordered_map<EntityID, size_t> previousIndex;
+    auto findPrevious = [&](EntityID entityID, size_t& index) {
+        if (previousIndex.empty()) {
+            previousIndex.reserve(previous->entities.size());
+            for (size_t i = 0; i < previous->entities.size(); i++) {
+                previousIndex[previous->entities[i]] = i;
+            }
+        }
+        auto it = previousIndex.find(entityID);
+        if (it == previousIndex.end()) {
+            return false;
+        }
+        index = it->second;
+        return true;
+    };
+
+    size_t matched = 0;
+    for (size_t i = 0; i < count; i++) {
+        EntityID entityID = pool.GetEntityID(i);
+        size_t index = i;
+
+        // Fast path: same entity at the same dense index
+        if (i >= previous->entities.size() || previous->entities[i] != entityID) {
+            if (!findPrevious(entityID, index)) {
+                out.added.push_back(entityID);
+                out.addedData.insert(out.addedData.end(), current + i * size,
+                                     current + (i + 1) * size);
+                continue;
+            }
+        }
+
+        matched++;
+        DiffComponent(entityID, previous->data.data() + index * size, current + i * size, size,
+                      out);
+    }
+
+    // Every previous entity that was not matched is gone
+    if (matched != previous->entities.size()) {
+        for (EntityID entityID : previous->entities) {
+            if (!pool.HasEntity(entityID)) {
+                out.removed.push_back(entityID);
+            }
+        }
+    }
+}
+
+} // namespace microECS
@@ -0,0 +1,263 @@
+#pragma once
+
+#include "Profile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace microECS {
+
+/**
+ * @brief One field of a component that is stored as a structure of arrays (SoA).
+ * See `SoAFields` for how a component opts in.
+ */
+struct FieldLayout {
+    size_t offset;     // Into the component
+    size_t size;
+    size_t alignment;
+    size_t column = 0; // Set by the pool: where the field's column starts, in bytes per slot
+};
+
+/**
+ * @brief The class and the type of the member behind a pointer to data member.
+ */
+template <typename Member>
+struct MemberPointer;
+
+template <typename C, typename F>
+struct MemberPointer<F C::*> {
+    using Class = C;
+    using Type = F;
+};
+
+// The type of the data member `Member` points to
+template <auto Member>
+using MemberType = typename MemberPointer<decltype(Member)>::Type;
+
+/**
+ * @brief Returns the offset of a data member in its class, like `offsetof` but for a member
+ * pointer. Components are trivially copyable, so no object has to be constructed for this.
+ */
+template <typename C, typename F>
+size_t MemberOffset(F C::*member) {
+    alignas(C) static unsigned char storage[sizeof(C)];
+    const C* object = reinterpret_cast<const C*>(storage);
+    return static_cast<size_t>(reinterpret_cast<const unsigned char*>(&(object->*member)) -
+                               storage);
+}
+
+/**
+ * @brief The fields of an SoA component, as pointers to its data members.
+ * Derive `SoAFields<T>` from it, or use `MECS_SOA`.
+ *
+ * @tparam Members Pointers to the data members of one class, in any order. Members that are
+ * not listed are not stored.
+ */
+template <auto... Members>
+struct FieldList {
+    static constexpr bool ENABLED = true;
+    static constexpr size_t COUNT = sizeof...(Members);
+
+    /**
+     * @brief Returns the position of `Member` in the list, or `COUNT` if it is not listed.
+     */
+    template <auto Member>
+    static constexpr size_t IndexOf() {
+        size_t index = 0;
+        size_t found = COUNT;
+        ((found = found == COUNT && Same<Member, Members>() ? index : found, index++), ...);
+        return found;
+    }
+
+    /**
+     * @brief Writes the layout of every field to `out`, which has room for `COUNT` fields.
+     */
+    static void Describe(FieldLayout* out) {
+        size_t i = 0;
+        ((out[i++] = { MemberOffset(Members), sizeof(MemberType<Members>),
+                       alignof(MemberType<Members>) }),
+         ...);
+    }
+
+    /**
+     * @brief Copies the fields of the component at `index` out of its columns.
+     */
+    template <typename T>
+    static void Load(T& out, uint8_t* const* columns, size_t index) {
+        size_t i = 0;
+        ((out.*Members = Column<Members>(columns[i++])[index]), ...);
+    }
+
+    /**
+     * @brief Copies the fields of `value` into the columns at `index`.
+     */
+    template <typename T>
+    static void Store(const T& value, uint8_t* const* columns, size_t index) {
+        size_t i = 0;
+        ((Column<Members>(columns[i++])[index] = value.*Members), ...);
+    }
+
+private:
+    template <auto A, auto B>
+    static constexpr bool Same() {
+        if constexpr (std::is_same_v<decltype(A), decltype(B)>) {
+            return A == B;
+        } else {
+            return false;
+        }
+    }
+
+    template <auto Member>
+    static MemberType<Member>* Column(uint8_t* column) {
+        return reinterpret_cast<MemberType<Member>*>(column);
+    }
+};
+
+/**
+ * @brief Opts a component type into structure-of-arrays storage: its pool keeps every field
+ * in its own column, so a system that reads a few fields of a large component only pulls
+ * those fields into cache. Specialize it for a component, deriving from `FieldList`, or use
+ * `MECS_SOA` at global scope:
+ *
+ * @code
+ * struct Particle { float x, y, z, vx, vy, vz, r, g, b, a, size, life; };
+ * MECS_SOA(Particle, x, y, z, vx, vy, vz, r, g, b, a, size, life);
+ * @endcode
+ *
+ * Views hand out an `SoARef<T>` instead of a `T&`, and `World::Field` returns a whole column.
+ * SoA components have no contiguous value, so `Entity::Get` is not available for them.
+ */
+template <typename T>
+struct SoAFields {
+    static constexpr bool ENABLED = false;
+    static constexpr size_t COUNT = 0;
+};
+
+template <typename T>
+constexpr bool IS_SOA = SoAFields<T>::ENABLED;
+
+/**
+ * @brief A reference to one component in SoA storage, handed out by views.
+ * Valid until the pool changes structurally, like a component pointer.
+ *
+ * @code
+ * world.View<Particle>().Each([](EntityID, microECS::SoARef<Particle> particle) {
+ *     particle.Get<&Particle::x>() += particle.Get<&Particle::vx>();
+ * });
+ * @endcode
+ */
+template <typename T>
+class SoARef {
+public:
+    using Fields = SoAFields<T>;
+
+    SoARef(uint8_t* const* columns, size_t index) : m_pColumns(columns), m_Index(index) {}
+
+#if defined(MECS_ENABLE_PROFILE)
+    // Profiling builds flag every field that is accessed in `touched`
+    SoARef(uint8_t* const* columns, size_t index, uint64_t* touched)
+        : m_pColumns(columns), m_Index(index), m_pTouched(touched) {}
+#endif
+
+    /**
+     * @brief Returns a reference to one field of the component.
+     *
+     * @tparam Member A pointer to the data member, e.g. `&Particle::x`.
+     */
+    template <auto Member>
+    MemberType<Member>& Get() const {
+        constexpr size_t FIELD = Fields::template IndexOf<Member>();
+        static_assert(FIELD < Fields::COUNT, "The member is not a field of the SoA component.");
+        MECS_PROFILE(Touch(FIELD < 64 ? uint64_t(1) << FIELD : 0));
+        return reinterpret_cast<MemberType<Member>*>(m_pColumns[FIELD])[m_Index];
+    }
+
+    /**
+     * @brief Gathers every field into a `T`. Fields that are not listed are value-initialized.
+     */
+    T Load() const {
+        MECS_PROFILE(Touch(~uint64_t(0) >> (64 - (Fields::COUNT < 64 ? Fields::COUNT : 64))));
+        T value {};
+        Fields::Load(value, m_pColumns, m_Index);
+        return value;
+    }
+
+    /**
+     * @brief Scatters every field of `value` into the columns.
+     */
+    void Store(const T& value) const {
+        MECS_PROFILE(Touch(~uint64_t(0) >> (64 - (Fields::COUNT < 64 ? Fields::COUNT : 64))));
+        Fields::Store(value, m_pColumns, m_Index);
+    }
+
+private:
+#if defined(MECS_ENABLE_PROFILE)
+    void Touch(uint64_t fields) const {
+        if (m_pTouched != nullptr) {
+            *m_pTouched |= fields;
+        }
+    }
+#endif
+
+    uint8_t* const* m_pColumns;
+    size_t m_Index;
+#if defined(MECS_ENABLE_PROFILE)
+    uint64_t* m_pTouched = nullptr;
+#endif
+};
+
+/**
+ * @brief A column of one field of an SoA component: `Data()[i]` belongs to the entity at
+ * dense index `i`, the same index in every column of the pool. Returned by `World::Field`
+ * and invalidated by any structural change of the pool.
+ */
+template <typename F>
+class FieldSpan {
+public:
+    FieldSpan(F* data, size_t size) : m_pData(data), m_Size(size) {}
+
+    F* Data() const { return m_pData; }
+    size_t Size() const { return m_Size; }
+
+    F& operator[](size_t index) const { return m_pData[index]; }
+    F* begin() const { return m_pData; }
+    F* end() const { return m_pData + m_Size; }
+
+private:
+    F* m_pData;
+    size_t m_Size;
+};
+
+} // namespace microECS
+
+// `MECS_SOA(Type, field, ...)` lists the fields of an SoA component, see `SoAFields`.
+// Takes 1 to 16 fields and must be used at global scope.
+#define MECS_SOA_EXPAND(x) x
+#define MECS_SOA_1(T, a) &T::a
+#define MECS_SOA_2(T, a, ...) &T::a, MECS_SOA_EXPAND(MECS_SOA_1(T, __VA_ARGS__))
+#define MECS_SOA_3(T, a, ...) &T::a, MECS_SOA_EXPAND(MECS_SOA_2(T, __VA_ARGS__))
+#define MECS_SOA_4(T, a, ...) &T::a, MECS_SOA_EXPAND(MECS_SOA_3(T, __VA_ARGS__))
+#define MECS_SOA_5(T, a, ...) &T::a, MECS_SOA_EXPAND(MECS_SOA_4(T, __VA_ARGS__))
+#define MECS_SOA_6(T, a, ...) &T::a, MECS_SOA_EXPAND(MECS_SOA_5(T, __VA_ARGS__))
+#define MECS_SOA_7(T, a, ...) &T::a, MECS_SOA_EXPAND(MECS_SOA_6(T, __VA_ARGS__))
+#define MECS_SOA_8(T, a, ...) &T::a, MECS_SOA_EXPAND(MECS_SOA_7(T, __VA_ARGS__))
+#define MECS_SOA_9(T, a, ...) &T::a, MECS_SOA_EXPAND(MECS_SOA_8(T, __VA_ARGS__))
+#define MECS_SOA_10(T, a, ...) &T::a, MECS_SOA_EXPAND(MECS_SOA_9(T, __VA_ARGS__))
+#define MECS_SOA_11(T, a, ...) &T::a, MECS_SOA_EXPAND(MECS_SOA_10(T, __VA_ARGS__))
+#define MECS_SOA_12(T, a, ...) &T::a, MECS_SOA_EXPAND(MECS_SOA_11(T, __VA_ARGS__))
+#define MECS_SOA_13(T, a, ...) &T::a, MECS_SOA_EXPAND(MECS_SOA_12(T, __VA_ARGS__))
+#define MECS_SOA_14(T, a, ...) &T::a, MECS_SOA_EXPAND(MECS_SOA_13(T, __VA_ARGS__))
+#define MECS_SOA_15(T, a, ...) &T::a, MECS_SOA_EXPAND(MECS_SOA_14(T, __VA_ARGS__))
+#define MECS_SOA_16(T, a, ...) &T::a, MECS_SOA_EXPAND(MECS_SOA_15(T, __VA_ARGS__))
+#define MECS_SOA_PICK(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16,    \
+                      NAME, ...)                                                                \
+    NAME
+#define MECS_SOA(Type, ...)                                                                     \
+    template <>                                                                                 \
+    struct microECS::SoAFields<Type>                                                            \
+        : microECS::FieldList<MECS_SOA_EXPAND(MECS_SOA_PICK(                                    \
+              __VA_ARGS__, MECS_SOA_16, MECS_SOA_15, MECS_SOA_14, MECS_SOA_13, MECS_SOA_12,     \
+              MECS_SOA_11, MECS_SOA_10, MECS_SOA_9, MECS_SOA_8, MECS_SOA_7, MECS_SOA_6,         \
+              MECS_SOA_5, MECS_SOA_4, MECS_SOA_3, MECS_SOA_2, MECS_SOA_1)(Type, __VA_ARGS__))> {}
@@ -0,0 +1,197 @@
+#pragma once
+
+#include "Assert.h"
+#include "Memory.h"
+#include "Types.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+
+namespace microECS {
+
+/**
+ * @class BasicSparseIndex
+ * @brief The sparse half of a sparse set: maps an EntityID to its dense index in a pool.
+ *
+ * Entries live in fixed-size pages that are allocated the first time an entity on that
+ * page is inserted, so memory follows the range of IDs actually used by the pool.
+ * A lookup is a page load and an entry load, without hashing.
+ * Every page counts its live entries, so `Shrink` can free the pages that became empty.
+ *
+ * Pages are keyed by the index part of an EntityID and hold `Traits::EntityIndex` entries,
+ * so narrower IDs give smaller pages. Generations are not stored here; the pool checks them
+ * against its dense entity array.
+ */
+template <typename Traits>
+class BasicSparseIndex {
+public:
+    using EntityID = typename Traits::EntityID;
+    using EntityIndex = typename Traits::EntityIndex;
+
+    static constexpr size_t SPARSE_PAGE_SIZE = Traits::SPARSE_PAGE_SIZE;
+    static constexpr EntityIndex INVALID_INDEX = std::numeric_limits<EntityIndex>::max();
+    STATIC_ASSERT(SPARSE_PAGE_SIZE <= UINT16_MAX, "Live entries per page are counted in 16 bits.");
+
+    explicit BasicSparseIndex(
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : m_Pages(resource), m_PageCounts(resource) {}
+
+    /**
+     * @brief Returns the dense index of `entityID`, or `INVALID_INDEX` if it is not present.
+     */
+    EntityIndex Get(EntityID entityID) const {
+        size_t index = Traits::GetIndex(entityID);
+        size_t page = index / SPARSE_PAGE_SIZE;
+        if (page >= m_Pages.size() || m_Pages[page].empty()) {
+            return INVALID_INDEX;
+        }
+
+        return m_Pages[page][index % SPARSE_PAGE_SIZE];
+    }
+
+    bool Contains(EntityID entityID) const { return Get(entityID) != INVALID_INDEX; }
+
+    /**
+     * @brief Maps `entityID` to `index`, allocating its page if needed.
+     */
+    void Set(EntityID entityID, size_t index) {
+        ASSERT(entityID != Traits::INVALID_ENTITY_ID, "Invalid entity ID.");
+        size_t page = Traits::GetIndex(entityID) / SPARSE_PAGE_SIZE;
+        EntityIndex& entry = Page(page)[Traits::GetIndex(entityID) % SPARSE_PAGE_SIZE];
+        if (entry == INVALID_INDEX) {
+            m_PageCounts[page]++;
+        }
+        entry = static_cast<EntityIndex>(index);
+    }
+
+    /**
+     * @brief Removes `entityID` from the index. The page stays allocated.
+     */
+    void Erase(EntityID entityID) {
+        size_t page = Traits::GetIndex(entityID) / SPARSE_PAGE_SIZE;
+        if (page < m_Pages.size() && !m_Pages[page].empty()) {
+            EntityIndex& entry = m_Pages[page][Traits::GetIndex(entityID) % SPARSE_PAGE_SIZE];
+            if (entry != INVALID_INDEX) {
+                entry = INVALID_INDEX;
+                m_PageCounts[page]--;
+            }
+        }
+    }
+
+    /**
+     * @brief Makes sure the pages covering the entity indices `[first, last]` are allocated,
+     * so a following run of `Set` calls does not allocate.
+     */
+    void Reserve(size_t first, size_t last) {
+        for (size_t page = first / SPARSE_PAGE_SIZE; page <= last / SPARSE_PAGE_SIZE; page++) {
+            Page(page);
+        }
+    }
+
+    /**
+     * @brief Makes sure the pages holding `count` entities are allocated. Unlike `Reserve`,
+     * pages between scattered entities are left alone.
+     */
+    void ReserveFor(const EntityID* entityIDs, size_t count) {
+        size_t lastPage = SIZE_MAX;
+        for (size_t i = 0; i < count; i++) {
+            size_t page = Traits::GetIndex(entityIDs[i]) / SPARSE_PAGE_SIZE;
+            if (page != lastPage) {
+                Page(page);
+                lastPage = page;
+            }
+        }
+    }
+
+    /**
+     * @brief Removes every entity from the index in O(pages), independent of the entity count.
+     *
+     * @param keepPages If `true`, allocated pages are reset and kept for reuse,
+     * otherwise they are freed.
+     */
+    void Clear(bool keepPages) {
+        if (!keepPages) {
+            m_Pages.clear();
+            m_Pages.shrink_to_fit();
+            m_PageCounts.clear();
+            m_PageCounts.shrink_to_fit();
+            return;
+        }
+
+        for (auto& page : m_Pages) {
+            if (!page.empty()) {
+                std::fill(page.begin(), page.end(), INVALID_INDEX);
+            }
+        }
+        std::fill(m_PageCounts.begin(), m_PageCounts.end(), 0);
+    }
+
+    /**
+     * @brief Frees every page without live entries and trims the page table.
+     * Costs O(pages), so callers should only shrink after many removals.
+     */
+    void Shrink() {
+        for (size_t page = 0; page < m_Pages.size(); page++) {
+            if (m_PageCounts[page] == 0 && !m_Pages[page].empty()) {
+                m_Pages[page] = Vector<EntityIndex>(m_Pages.get_allocator());
+            }
+        }
+
+        size_t used = m_Pages.size();
+        while (used > 0 && m_Pages[used - 1].empty()) { used--; }
+        m_Pages.resize(used);
+        m_Pages.shrink_to_fit();
+        m_PageCounts.resize(used);
+        m_PageCounts.shrink_to_fit();
+    }
+
+    /**
+     * @brief Returns the number of bytes used by the page table and the allocated pages.
+     */
+    size_t GetMemoryUsage() const {
+        size_t bytes = m_Pages.capacity() * sizeof(Vector<EntityIndex>) +
+                       m_PageCounts.capacity() * sizeof(uint16_t);
+        for (auto& page : m_Pages) { bytes += page.capacity() * sizeof(EntityIndex); }
+        return bytes;
+    }
+
+    /**
+     * @brief Returns the number of page slots (allocated or not).
+     */
+    size_t GetPageCount() const { return m_Pages.size(); }
+
+    /**
+     * @brief Returns the number of allocated pages.
+     */
+    size_t GetAllocatedPageCount() const {
+        size_t count = 0;
+        for (auto& page : m_Pages) { count += !page.empty(); }
+        return count;
+    }
+
+private:
+    Vector<EntityIndex>& Page(size_t page) {
+        if (page >= m_Pages.size()) {
+            m_Pages.resize(page + 1);
+            m_PageCounts.resize(page + 1, 0);
+        }
+        if (m_Pages[page].empty()) {
+            // Allocate from the index's resource, not the one of the empty placeholder
+            m_Pages[page] =
+                Vector<EntityIndex>(SPARSE_PAGE_SIZE, INVALID_INDEX, m_Pages.get_allocator());
+        }
+
+        return m_Pages[page];
+    }
+
+private:
+    Vector<Vector<EntityIndex>> m_Pages;
+    Vector<uint16_t> m_PageCounts; // Live entries per page
+};
+
+using SparseIndex = BasicSparseIndex<DefaultIDTraits>;
+
+} // namespace microECS
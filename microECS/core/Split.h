@@ -0,0 +1,59 @@
+#pragma once
+
+#include <type_traits>
+
+namespace microECS {
+
+/**
+ * @brief The two parts of a split component, see `SplitComponent`.
+ *
+ * @tparam HotPart The fields that tight loops read every frame.
+ * @tparam ColdPart The fields that are only touched now and then.
+ */
+template <typename HotPart, typename ColdPart>
+struct SplitPair {
+    static_assert(!std::is_empty_v<HotPart> && !std::is_empty_v<ColdPart>,
+                  "Tags cannot be split.");
+    static_assert(!std::is_same_v<HotPart, ColdPart>, "The parts must be different types.");
+
+    static constexpr bool ENABLED = true;
+    using Hot = HotPart;
+    using Cold = ColdPart;
+};
+
+/**
+ * @brief Declares a hot and a cold component type to be the two parts of one logical
+ * component. Both are regular components with their own pool, but the pools share the
+ * entity index of the hot pool and keep the same dense order, so component `i` of the cold
+ * pool belongs to the entity of component `i` of the hot pool. A loop over the hot part only
+ * pulls the hot part into cache, and looking up the cold part costs no second index.
+ *
+ * Adding or removing either part adds or removes both; the part that is not given gets its
+ * default value. Use `MECS_SPLIT` at global scope:
+ *
+ * @code
+ * struct Motion { float x, y, vx, vy; };
+ * struct MotionHistory { float spawnX, spawnY; uint32_t bounces; char label[52]; };
+ * MECS_SPLIT(Motion, MotionHistory);
+ * @endcode
+ *
+ * @note Split components cannot be sorted or imported with `ImportColumn`, as either would
+ * change one dense order without the other.
+ */
+template <typename T>
+struct SplitComponent {
+    static constexpr bool ENABLED = false;
+};
+
+template <typename T>
+constexpr bool IS_SPLIT = SplitComponent<T>::ENABLED;
+
+} // namespace microECS
+
+// `MECS_SPLIT(Hot, Cold)` declares a split component, see `SplitComponent`.
+// Must be used at global scope.
+#define MECS_SPLIT(Hot, Cold)                                                                   \
+    template <>                                                                                 \
+    struct microECS::SplitComponent<Hot> : microECS::SplitPair<Hot, Cold> {};                  \
+    template <>                                                                                 \
+    struct microECS::SplitComponent<Cold> : microECS::SplitPair<Hot, Cold> {}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace microECS {
+
+/**
+ * @brief Memory use and occupancy of one component pool.
+ */
+struct PoolStats {
+    std::string name;
+    size_t componentSize = 0;
+    size_t capacity = 0;      // Components the pool can hold without growing
+    size_t count = 0;         // Live components
+    size_t highWaterMark = 0; // Largest count the pool ever had
+    size_t resizeCount = 0;   // Number of times the dense storage was reallocated
+    float addRate = 0.0f;     // Observed adds per frame, see `World::EndFrame`
+    size_t denseBytes = 0;    // Owned component storage
+    size_t mappedBytes = 0;   // Component storage in a file mapping or a borrowed buffer
+    size_t indexBytes = 0;    // Sparse index pages and the dense-to-entity array
+    size_t sharedValueCount = 0; // Distinct values of a shared pool, see `MakeShared`
+};
+
+/**
+ * @brief Memory use of a whole World, as reported by `World::Stats`.
+ * Container overhead of the free list and the name table is estimated.
+ */
+struct WorldStats {
+    std::vector<PoolStats> pools;
+
+    size_t entityCount = 0;    // Entity IDs handed out and not released
+    size_t freeEntityCount = 0;
+    size_t freeListBytes = 0;  // Entity records, which also hold the free list
+    size_t nameCount = 0;
+    size_t nameBytes = 0;
+    size_t singletonCount = 0;
+    size_t singletonBytes = 0;
+
+    // Sums over all pools
+    size_t resizeCount = 0;
+    size_t denseBytes = 0;
+    size_t mappedBytes = 0;
+    size_t indexBytes = 0;
+
+    /**
+     * @brief Returns the total number of bytes owned by the World (mapped data excluded).
+     */
+    size_t TotalBytes() const {
+        return denseBytes + indexBytes + freeListBytes + nameBytes + singletonBytes;
+    }
+};
+
+} // namespace microECS
@@ -0,0 +1,198 @@
+#pragma once
+
+/**
+ * @brief Low-overhead tracing of microECS internals.
+ *
+ * Define `MECS_ENABLE_TRACE` (before including microECS) to record timestamped begin/end
+ * events into a per-thread ring buffer, and write them out with `World::DumpTrace` as Chrome
+ * `trace_event` JSON (open it in chrome://tracing or Perfetto).
+ * Without `MECS_ENABLE_TRACE` the macros expand to nothing.
+ *
+ * @code
+ * void MySystem() {
+ *     MECS_TRACE_SCOPE("MySystem");
+ *     ...
+ * }
+ * @endcode
+ *
+ * @note Event names must be string literals (or otherwise outlive the trace).
+ */
+
+#if defined(MECS_ENABLE_TRACE)
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifndef MECS_TRACE_BUFFER_SIZE
+// Events kept per thread, must be a power of two
+#define MECS_TRACE_BUFFER_SIZE (1u << 16)
+#endif
+
+namespace microECS {
+
+struct TraceEvent {
+    const char* name;
+    uint64_t timestamp; // Nanoseconds since the trace epoch
+    char phase;         // 'B' (begin) or 'E' (end)
+};
+
+/**
+ * @class TraceBuffer
+ * @brief A single-producer ring buffer of trace events owned by one thread.
+ * Only the owning thread writes; the write index is published with release semantics so a
+ * reader never sees a slot before it is written. Once full, the oldest events are overwritten.
+ */
+class TraceBuffer {
+public:
+    static_assert((MECS_TRACE_BUFFER_SIZE & (MECS_TRACE_BUFFER_SIZE - 1)) == 0,
+                  "MECS_TRACE_BUFFER_SIZE must be a power of two.");
+
+    explicit TraceBuffer(uint32_t threadID) : m_ThreadID(threadID), m_Events(MECS_TRACE_BUFFER_SIZE) {}
+
+    void Push(const char* name, uint64_t timestamp, char phase) {
+        uint64_t head = m_Head.load(std::memory_order_relaxed);
+        m_Events[head & (MECS_TRACE_BUFFER_SIZE - 1)] = { name, timestamp, phase };
+        m_Head.store(head + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copies the events currently in the ring, oldest first.
+     */
+    void Read(std::vector<TraceEvent>& out) const {
+        uint64_t head = m_Head.load(std::memory_order_acquire);
+        uint64_t count = head < MECS_TRACE_BUFFER_SIZE ? head : MECS_TRACE_BUFFER_SIZE;
+        for (uint64_t i = head - count; i < head; i++) {
+            out.push_back(m_Events[i & (MECS_TRACE_BUFFER_SIZE - 1)]);
+        }
+    }
+
+    void Clear() { m_Head.store(0, std::memory_order_release); }
+
+    uint32_t GetThreadID() const { return m_ThreadID; }
+
+private:
+    uint32_t m_ThreadID;
+    std::atomic<uint64_t> m_Head { 0 };
+    std::vector<TraceEvent> m_Events;
+};
+
+/**
+ * @brief Process-wide trace state: the epoch and the list of thread buffers.
+ * The list is only locked when a thread records its first event and when dumping.
+ */
+class Trace {
+public:
+    static void Record(const char* name, char phase) {
+        uint64_t timestamp = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - Epoch())
+                .count());
+        ThreadBuffer().Push(name, timestamp, phase);
+    }
+
+    /**
+     * @brief Writes the events of every thread as Chrome `trace_event` JSON.
+     *
+     * @param path The file to write.
+     * @return `true` on success.
+     */
+    static bool WriteChromeJson(const std::string& path) {
+        FILE* file = std::fopen(path.c_str(), "w");
+        if (file == nullptr) {
+            return false;
+        }
+
+        std::fprintf(file, "{\"traceEvents\":[\n");
+        bool first = true;
+        std::vector<TraceEvent> events;
+
+        std::lock_guard<std::mutex> lock(Mutex());
+        for (auto& buffer : Buffers()) {
+            events.clear();
+            buffer->Read(events);
+            for (const TraceEvent& event : events) {
+                std::fprintf(file, "%s{\"name\":\"%s\",\"cat\":\"microECS\",\"ph\":\"%c\","
+                                   "\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+                             first ? "" : ",\n", event.name, event.phase,
+                             static_cast<double>(event.timestamp) / 1000.0,
+                             buffer->GetThreadID());
+                first = false;
+            }
+        }
+        std::fprintf(file, "\n]}\n");
+
+        return std::fclose(file) == 0;
+    }
+
+    /**
+     * @brief Drops all recorded events.
+     */
+    static void Clear() {
+        std::lock_guard<std::mutex> lock(Mutex());
+        for (auto& buffer : Buffers()) { buffer->Clear(); }
+    }
+
+private:
+    static TraceBuffer& ThreadBuffer() {
+        // Shared with the global list, so events survive the thread until they are dumped
+        thread_local std::shared_ptr<TraceBuffer> buffer = [] {
+            std::lock_guard<std::mutex> lock(Mutex());
+            auto created = std::make_shared<TraceBuffer>(static_cast<uint32_t>(Buffers().size()));
+            Buffers().push_back(created);
+            return created;
+        }();
+        return *buffer;
+    }
+
+    static std::chrono::steady_clock::time_point Epoch() {
+        static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+        return epoch;
+    }
+
+    static std::mutex& Mutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    static std::vector<std::shared_ptr<TraceBuffer>>& Buffers() {
+        static std::vector<std::shared_ptr<TraceBuffer>> buffers;
+        return buffers;
+    }
+};
+
+/**
+ * @brief Records a begin event on construction and the matching end event on destruction.
+ */
+class TraceScope {
+public:
+    explicit TraceScope(const char* name) : m_Name(name) { Trace::Record(name, 'B'); }
+    ~TraceScope() { Trace::Record(m_Name, 'E'); }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_Name;
+};
+
+} // namespace microECS
+
+#define MECS_TRACE_CONCAT_IMPL(a, b) a##b
+#define MECS_TRACE_CONCAT(a, b)      MECS_TRACE_CONCAT_IMPL(a, b)
+#define MECS_TRACE_SCOPE(name)       ::microECS::TraceScope MECS_TRACE_CONCAT(mecsTraceScope, __LINE__)(name)
+#define MECS_TRACE_BEGIN(name)       ::microECS::Trace::Record(name, 'B')
+#define MECS_TRACE_END(name)         ::microECS::Trace::Record(name, 'E')
+
+#else
+
+#define MECS_TRACE_SCOPE(name) ((void)0)
+#define MECS_TRACE_BEGIN(name) ((void)0)
+#define MECS_TRACE_END(name)   ((void)0)
+
+#endif
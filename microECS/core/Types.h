@@ -1,16 +1,117 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <type_traits>
 
 namespace microECS
 {
-    using EntityID = uint32_t;
-    using ComponentID = uint8_t;
+    /**
+     * @brief Describes the integer types behind entity and component IDs.
+     * `World`, `Registry`, `ComponentPool` and `View` take one as their `Traits` parameter;
+     * see `DefaultIDTraits`, `CompactIDTraits` and `HandleIDTraits`.
+     *
+     * An EntityID holds an index in its low `IndexBits` and a generation in the bits above.
+     * Sparse pages and free lists are addressed by the index. The generation is bumped every
+     * time an index is released, so a handle to a destroyed entity stops matching once its
+     * index is reused. When `IndexBits` covers the whole EntityID there is no generation and
+     * IDs are plain indices.
+     *
+     * @tparam Entity The unsigned integer type of EntityIDs.
+     * @tparam Component The unsigned integer type of ComponentIDs.
+     * @tparam PageSize The number of entities per page of a sparse index.
+     * @tparam IndexBits The low bits of an EntityID that hold its index.
+     */
+    template <typename Entity, typename Component, size_t PageSize,
+              unsigned IndexBits = std::numeric_limits<Entity>::digits>
+    struct IDTraits
+    {
+        static_assert(std::is_unsigned_v<Entity> && std::is_unsigned_v<Component>,
+                      "IDs must be unsigned integers.");
+        static_assert(IndexBits > 0 && IndexBits <= std::numeric_limits<Entity>::digits,
+                      "The index must fit in the EntityID.");
+        static_assert(PageSize > 0 && (PageSize & (PageSize - 1)) == 0,
+                      "The sparse page size must be a power of two.");
+
+        using EntityID = Entity;
+        using ComponentID = Component;
+
+        // The smallest type that holds an index, used for sparse entries and dense indices
+        using EntityIndex = std::conditional_t<
+            IndexBits <= 16, uint16_t, std::conditional_t<IndexBits <= 32, uint32_t, uint64_t>>;
+
+        static constexpr unsigned INDEX_BITS = IndexBits;
+        static constexpr unsigned GENERATION_BITS = std::numeric_limits<Entity>::digits - IndexBits;
+        static constexpr size_t SPARSE_PAGE_SIZE = PageSize;
+
+        static constexpr EntityID INVALID_ENTITY_ID = std::numeric_limits<Entity>::max();
+        static constexpr ComponentID INVALID_COMPONENT_ID = std::numeric_limits<Component>::max();
+        static constexpr size_t MAX_COMPONENT_TYPES = std::numeric_limits<Component>::max() - 1;
+
+        // Also the largest number of indices, as the all-ones index is never handed out
+        static constexpr EntityIndex INDEX_MASK =
+            static_cast<EntityIndex>(INVALID_ENTITY_ID >> GENERATION_BITS);
+
+        static constexpr EntityIndex GetIndex(EntityID entityID)
+        {
+            return static_cast<EntityIndex>(entityID & INDEX_MASK);
+        }
+
+        static constexpr EntityID GetGeneration(EntityID entityID)
+        {
+            if constexpr (GENERATION_BITS == 0)
+            {
+                return 0;
+            }
+            else
+            {
+                return static_cast<EntityID>(entityID >> INDEX_BITS);
+            }
+        }
+
+        static constexpr EntityID MakeID(EntityIndex index, EntityID generation)
+        {
+            if constexpr (GENERATION_BITS == 0)
+            {
+                return static_cast<EntityID>(index);
+            }
+            else
+            {
+                return static_cast<EntityID>((generation << INDEX_BITS) | index);
+            }
+        }
+
+        /**
+         * @brief Returns the ID the index of `entityID` gets when it is reused.
+         * The generation wraps around after `2^GENERATION_BITS` reuses.
+         */
+        static constexpr EntityID NextGeneration(EntityID entityID)
+        {
+            return MakeID(GetIndex(entityID), GetGeneration(entityID) + 1);
+        }
+    };
+
+    // 32-bit entity IDs without generations and up to 254 component types
+    using DefaultIDTraits = IDTraits<uint32_t, uint8_t, 4096>;
+
+    // 16-bit entity IDs for small worlds, with 2 KiB sparse pages instead of 16 KiB
+    using CompactIDTraits = IDTraits<uint16_t, uint8_t, 1024>;
+
+    // 64-bit handles (32-bit index + 32-bit generation) and up to 65534 component types
+    using HandleIDTraits = IDTraits<uint64_t, uint16_t, 4096, 32>;
+
+    using EntityID = DefaultIDTraits::EntityID;
+    using ComponentID = DefaultIDTraits::ComponentID;
 
     constexpr size_t INIT_COMPONENT_POOL_SIZE = 32;
-    constexpr uint8_t INVALID_COMPONENT_ID = std::numeric_limits<uint8_t>::max();
-    constexpr uint32_t INVALID_ENTITY_ID = std::numeric_limits<uint32_t>::max();
+    constexpr size_t SPARSE_PAGE_SIZE = DefaultIDTraits::SPARSE_PAGE_SIZE;
+    constexpr ComponentID INVALID_COMPONENT_ID = DefaultIDTraits::INVALID_COMPONENT_ID;
+    constexpr EntityID INVALID_ENTITY_ID = DefaultIDTraits::INVALID_ENTITY_ID;
     constexpr size_t INVALID_COLUMN_INDEX = std::numeric_limits<size_t>::max();
-    constexpr size_t MAX_COMPONENT_TYPES = std::numeric_limits<uint8_t>::max() - 1;
-}
\ No newline at end of file
+    constexpr size_t MAX_COMPONENT_TYPES = DefaultIDTraits::MAX_COMPONENT_TYPES;
+
+    // Bytes a component of type `T` takes in its pool. Empty types are tags and take none.
+    template <typename T>
+    constexpr size_t COMPONENT_SIZE = std::is_empty_v<T> ? 0 : sizeof(T);
+}
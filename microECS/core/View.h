@@ -3,43 +3,111 @@
 #include "ComponentPool.h"
 #include "Entity.h"
 #include "Registry.h"
+#include "Shared.h"
+#include "SoA.h"
+#include "Trace.h"
 #include "Types.h"
 
+#include <array>
 #include <functional>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
 namespace microECS
 {
-    template <typename... T>
-    class View
+    /**
+     * @brief Iterates the entities that have all of the components `T`.
+     * Tags (empty components) only filter the entities; they are not passed to the lambda,
+     * e.g. `View<Position, Enemy>().Each([](EntityID id, Position& position) { ... })`.
+     * SoA components (see `SoAFields`) are passed as an `SoARef<T>` instead of a `T&`, and
+     * shared components (see `SharedComponent`) as a `const T&`.
+     *
+     * @tparam Traits The ID types of the World, see `IDTraits`.
+     */
+    template <typename Traits, typename... T>
+    class BasicView
     {
     public:
-        View(Registry* registry) : m_Registry(registry) {}
+        using EntityID = typename Traits::EntityID;
+        using ComponentID = typename Traits::ComponentID;
+        using ComponentPool = BasicComponentPool<Traits>;
+        using Entity = BasicEntity<Traits>;
+        using Registry = BasicRegistry<Traits>;
+
+        BasicView(Registry* registry) : m_Registry(registry) {}
 
         template <typename Func>
         void Each(Func func)
         {
+            MECS_TRACE_SCOPE("View::Each");
+
             // If there is only one component, we can directly access the component pool and iterate over the entities.
             if constexpr (sizeof...(T) == 1)
             {
-                ComponentID componentID = {m_Registry->GetComponentID<T>()...};
-                ComponentPool& componentPool = m_Registry->GetComponentPool(componentID);
+                // Tags and shared values are only read, so a pool shared with a fork is not
+                // copied for them
+                const Registry& registry = *m_Registry;
+                ComponentID componentID = {m_Registry->template GetComponentID<T>()...};
+                const ComponentPool& readPool = registry.GetComponentPool(componentID);
 
                 // If the pool is empty, there's nothing to iterate over.
-                if (componentPool.Size() == 0)
+                if (readPool.Size() == 0)
                 {
                     return;
                 }
 
-                for (size_t i = 0; i < componentPool.Size(); i++)
+                // A tag pool is only a list of entities
+                if constexpr ((std::is_empty_v<T> && ...))
                 {
-                    EntityID entityID = componentPool.GetEntityID(i);
-                    func(entityID, *static_cast<T*>(componentPool[i])...);
+                    for (size_t i = 0; i < readPool.Size(); i++)
+                    {
+                        func(readPool.GetEntityID(i));
+                    }
+                    MECS_PROFILE(readPool.RecordPass(readPool.Size(), 0));
+                    return;
+                }
+                else if constexpr ((IS_SOA<T> && ...))
+                {
+                    Columns<T...> columns;
+                    GetColumns(columns);
+
+                    const ComponentPool& componentPool = *columns.pool;
+                    for (size_t i = 0; i < componentPool.Size(); i++)
+                    {
+                        func(componentPool.GetEntityID(i), MakeRef(columns, i));
+                    }
+                    MECS_PROFILE(componentPool.RecordPass(componentPool.Size(), columns.touched));
+                }
+                else if constexpr ((IS_SHARED<T> && ...))
+                {
+                    const SharedValueStore& values = readPool.GetSharedValues();
+                    for (size_t i = 0; i < readPool.Size(); i++)
+                    {
+                        const void* value = values.Get(readPool.GetSharedIndex(i));
+                        func(readPool.GetEntityID(i), *static_cast<const T*>(value)...);
+                    }
+                    MECS_PROFILE(readPool.RecordPass(readPool.Size(), 0));
+                }
+                else
+                {
+                    // Components are handed out mutable, so the pool counts as modified
+                    ComponentPool& componentPool = m_Registry->GetComponentPool(componentID);
+                    componentPool.MarkModified();
+
+                    for (size_t i = 0; i < componentPool.Size(); i++)
+                    {
+                        EntityID entityID = componentPool.GetEntityID(i);
+                        func(entityID, *static_cast<T*>(componentPool[i])...);
+                    }
+                    MECS_PROFILE(componentPool.RecordPass(componentPool.Size(), 0));
                 }
             }
             else
             {
-                ComponentPool& smallestPool = GetSmallestComponentPool<T...>();
+                // Only the entities of the smallest pool are read, each component is fetched
+                // for writing through the entity
+                const ComponentPool& smallestPool = GetSmallestComponentPool<T...>();
 
                 // If the pool is empty, there's nothing to iterate over.
                 if (smallestPool.Size() == 0)
@@ -47,25 +115,190 @@ namespace microECS
                     return;
                 }
 
+                // The columns of SoA components are looked up once, not per entity
+                std::tuple<Columns<T>...> columns;
+                std::apply([&](auto&... c) { (GetColumns(c), ...); }, columns);
+
+                [[maybe_unused]] size_t matched = 0;
                 for (size_t i = 0; i < smallestPool.Size(); i++)
                 {
                     EntityID entityID = smallestPool.GetEntityID(i);
                     Entity entity(entityID, m_Registry);
-                    if (entity.Has<T...>())
+                    if (entity.template Has<T...>())
                     {
+                        MECS_PROFILE(matched++);
                         // This could be modified like the sizeof 1 case without Get<T>()?
-                        func(entityID, *entity.Get<T>()...);
+                        std::apply(
+                            [&](auto&... c)
+                            {
+                                std::apply([&](auto&&... components)
+                                           { func(entityID, components...); },
+                                           std::tuple_cat(GetArgument<T>(entity, c)...));
+                            },
+                            columns);
                     }
                 }
+#if defined(MECS_ENABLE_PROFILE)
+                std::apply([&](auto&... c) { (RecordPass(c, matched), ...); }, columns);
+#endif
             }
         }
 
+        /**
+         * @brief Calls `func` once per distinct value of the shared component that comes first
+         * in `T` (see `SharedComponent`), with the entities that hold that value and have all
+         * of the other components, e.g.
+         * `View<MaterialParams, Visible>().EachGroup([](const MaterialParams& material,
+         * const EntityID* entities, size_t count) { ... })`.
+         * Groups come in no particular order and are never empty; the entities of a group are
+         * in the dense order of the shared pool.
+         *
+         * @warning `func` must not add or set shared values of the grouped component, which may
+         * move the value it was handed, nor group again, as all groupings share one scratch.
+         */
+        template <typename Func>
+        void EachGroup(Func func)
+        {
+            using Shared = std::tuple_element_t<0, std::tuple<T...>>;
+            static_assert(IS_SHARED<Shared>, "EachGroup needs a shared component first.");
+            MECS_TRACE_SCOPE("View::EachGroup");
+
+            const Registry& registry = *m_Registry;
+            const ComponentPool& pool =
+                registry.GetComponentPool(m_Registry->template GetComponentID<Shared>());
+            const SharedValueStore& values = pool.GetSharedValues();
+            if (pool.Size() == 0)
+            {
+                return;
+            }
+
+            // Counting sort of the matching entities by the index of their value
+            typename Registry::GroupScratch& scratch = m_Registry->GetGroupScratch();
+            Vector<SharedIndex>& keys = scratch.keys;
+            Vector<size_t>& ends = scratch.ends;
+            keys.assign(pool.Size(), SharedValueStore::INVALID_INDEX);
+            ends.assign(values.GetSlotCount(), 0);
+            size_t matched = 0;
+            for (size_t i = 0; i < pool.Size(); i++)
+            {
+                if constexpr (sizeof...(T) > 1)
+                {
+                    if (!Entity(pool.GetEntityID(i), m_Registry).template Has<T...>())
+                    {
+                        continue;
+                    }
+                }
+                keys[i] = pool.GetSharedIndex(i);
+                ends[keys[i]]++;
+                matched++;
+            }
+
+            size_t start = 0;
+            for (size_t& end : ends)
+            {
+                start += end;
+                end = start - end;
+            }
+
+            Vector<EntityID>& entities = scratch.entities;
+            entities.resize(matched);
+            for (size_t i = 0; i < pool.Size(); i++)
+            {
+                if (keys[i] != SharedValueStore::INVALID_INDEX)
+                {
+                    entities[ends[keys[i]]++] = pool.GetEntityID(i);
+                }
+            }
+
+            // Every group now ends where the next one starts
+            start = 0;
+            for (size_t index = 0; index < ends.size(); index++)
+            {
+                if (ends[index] > start)
+                {
+                    func(*static_cast<const Shared*>(values.Get(static_cast<SharedIndex>(index))),
+                         entities.data() + start, ends[index] - start);
+                    start = ends[index];
+                }
+            }
+            MECS_PROFILE(pool.RecordPass(matched, 0));
+        }
+
     private:
+        // The pool of an SoA component and the start of each of its columns
+        template <typename Component>
+        struct Columns
+        {
+            ComponentPool* pool = nullptr;
+            std::array<uint8_t*, SoAFields<Component>::COUNT> data {};
+            uint64_t touched = 0; // Fields accessed during the pass, in profiling builds
+        };
+
+        template <typename Component>
+        static SoARef<Component> MakeRef(Columns<Component>& columns, size_t index)
+        {
+#if defined(MECS_ENABLE_PROFILE)
+            return SoARef<Component>(columns.data.data(), index, &columns.touched);
+#else
+            return SoARef<Component>(columns.data.data(), index);
+#endif
+        }
+
+#if defined(MECS_ENABLE_PROFILE)
+        // Counts a multi-component pass on the pool of every component, tags included
+        template <typename Component>
+        void RecordPass(const Columns<Component>& columns, size_t visited)
+        {
+            const Registry& registry = *m_Registry;
+            ComponentID componentID = m_Registry->template GetComponentID<Component>();
+            registry.GetComponentPool(componentID).RecordPass(visited, columns.touched);
+        }
+#endif
+
+        template <typename Component>
+        void GetColumns(Columns<Component>& columns)
+        {
+            if constexpr (IS_SOA<Component>)
+            {
+                ComponentPool& pool = m_Registry->GetComponentPool(
+                    m_Registry->template GetComponentID<Component>());
+                columns.pool = &pool;
+                for (size_t f = 0; f < columns.data.size(); f++)
+                {
+                    columns.data[f] = static_cast<uint8_t*>(pool.GetFieldData(f));
+                }
+            }
+        }
+
+        // Tags have no data to hand out, so they add no argument
+        template <typename Component>
+        static auto GetArgument(Entity& entity, Columns<Component>& columns)
+        {
+            if constexpr (std::is_empty_v<Component>)
+            {
+                return std::tuple<>();
+            }
+            else if constexpr (IS_SOA<Component>)
+            {
+                size_t index = columns.pool->GetEntities().Get(entity.GetID());
+                return std::tuple<SoARef<Component>>(MakeRef(columns, index));
+            }
+            else if constexpr (IS_SHARED<Component>)
+            {
+                return std::tuple<const Component&>(*entity.template Get<Component>());
+            }
+            else
+            {
+                return std::tuple<Component&>(*entity.template Get<Component>());
+            }
+        }
+
         template <typename... Components>
-        ComponentPool& GetSmallestComponentPool()
+        const ComponentPool& GetSmallestComponentPool()
         {
-            ComponentID componentIDs[] = {m_Registry->GetComponentID<Components>()...};
-            ComponentPool& smallestComponentPool = m_Registry->GetSmallestComponentPool(componentIDs, sizeof...(Components));
+            ComponentID componentIDs[] = {m_Registry->template GetComponentID<Components>()...};
+            const Registry& registry = *m_Registry;
+            const ComponentPool& smallestComponentPool = registry.GetSmallestComponentPool(componentIDs, sizeof...(Components));
 
             return smallestComponentPool;
         }
@@ -73,4 +306,20 @@ namespace microECS
     private:
         Registry* m_Registry;
     };
+
+    /**
+     * @brief A view of a World with the default ID types. A class rather than an alias, so
+     * `microECS::View view = world.View<Position>()` deduces the components.
+     */
+    template <typename... T>
+    class View : public BasicView<DefaultIDTraits, T...>
+    {
+    public:
+        using BasicView<DefaultIDTraits, T...>::BasicView;
+
+        View(const BasicView<DefaultIDTraits, T...>& view)
+            : BasicView<DefaultIDTraits, T...>(view)
+        {
+        }
+    };
 }
\ No newline at end of file
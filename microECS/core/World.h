@@ -1,23 +1,88 @@
 #pragma once
 
+#include "Capacity.h"
+#include "CommandBuffer.h"
 #include "Entity.h"
+#include "Memory.h"
+#include "Prefab.h"
 #include "Registry.h"
+#include "Rollback.h"
+#include "Trace.h"
 #include "Types.h"
 #include "View.h"
 
 #include <functional>
+#include <memory>
+#include <memory_resource>
 #include <string>
+#include <type_traits>
 #include <typeindex>
 #include <utility>
+#include <vector>
 
 namespace microECS {
 /**
  * @brief The World class is the main entry point for the ECS system.
  * It provides functionality to create and manage entities within the world.
  * There can be multiple worlds in a single application, but they are completely isolated from each other.
+ *
+ * The widths of entity and component IDs come from `Traits` (see `IDTraits`). `World` uses
+ * `DefaultIDTraits`; a world with different IDs is declared as e.g.
+ * `microECS::BasicWorld<microECS::HandleIDTraits>`.
  */
-class World {
+template <typename Traits>
+class BasicWorld {
 public:
+    using EntityID = typename Traits::EntityID;
+    using ComponentID = typename Traits::ComponentID;
+    using ComponentPool = BasicComponentPool<Traits>;
+    using Registry = BasicRegistry<Traits>;
+    using RollbackBuffer = BasicRollbackBuffer<Traits>;
+    using WorldCapacity = BasicWorldCapacity<Traits>;
+    using PoolSnapshot = BasicPoolSnapshot<Traits>;
+    using WorldSnapshot = BasicWorldSnapshot<Traits>;
+    using PoolDelta = BasicPoolDelta<Traits>;
+    using WorldDelta = BasicWorldDelta<Traits>;
+    using CommandBuffer = BasicCommandBuffer<Traits>;
+
+    BasicWorld() = default;
+
+    /**
+     * @brief Creates a world that takes every allocation it makes from `resource`:
+     * component storage, entity indices, pools, names, the free list, singletons and
+     * rollback buffers. Use it to place a world in its own arena, or pass a
+     * `CountingResource` to measure what the world allocates.
+     *
+     * @param resource The memory resource. Must outlive the world and all of its forks.
+     */
+    explicit BasicWorld(std::pmr::memory_resource* resource)
+        : m_Registry(resource), m_Rollback(resource) {}
+
+    /**
+     * @brief Creates a fixed-capacity world for deterministic, allocation-free operation.
+     * One slab of `capacity.slabBytes` is allocated here and everything else comes from it.
+     * Pools are created with their full capacity, so once every component type is registered
+     * (see `Register`), creating and destroying entities and adding and removing components
+     * never allocate. When a limit is reached, creating entities and adding components fail
+     * (returning `INVALID_ENTITY_ID`, `nullptr` or `false`) instead of growing.
+     *
+     * @note Names, singletons and new component types take slab space that is only
+     * reclaimed with the world. If the slab runs out, allocation throws `std::bad_alloc`.
+     * @warning Forks of a fixed-capacity world share its slab and must not outlive it.
+     *
+     * @param capacity The limits of the world, e.g. from `WorldCapacity::For<Ts...>`.
+     * @param upstream The resource the slab is allocated from.
+     */
+    explicit BasicWorld(const WorldCapacity& capacity,
+                        std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : m_pSlab(std::make_unique<SlabResource>(capacity.slabBytes, upstream)),
+          m_Registry(m_pSlab.get()), m_Rollback(m_pSlab.get()) {
+        m_Registry.SetFixedCapacity(capacity.maxEntities, capacity.poolCapacity);
+    }
+
+    BasicWorld(BasicWorld&&) = default;
+    BasicWorld& operator=(BasicWorld&&) = default;
+
     /**
      * @brief Creates a new Entity.
      * Entity is a wrapper around an EntityID to allow
@@ -26,9 +91,9 @@ public:
      * @overload Entity(const std::string& name)
      * @return Entity
      */
-    microECS::Entity Entity() {
+    BasicEntity<Traits> Entity() {
         EntityID id = m_Registry.CreateEntity();
-        return microECS::Entity(id, &m_Registry);
+        return BasicEntity<Traits>(id, &m_Registry);
     }
 
     /**
@@ -40,8 +105,8 @@ public:
      * @param name The name of the Entity.
      * @return Entity
      */
-    microECS::Entity Entity(const std::string& name) {
-        return microECS::Entity(m_Registry.CreateEntity(name), &m_Registry);
+    BasicEntity<Traits> Entity(const std::string& name) {
+        return BasicEntity<Traits>(m_Registry.CreateEntity(name), &m_Registry);
     }
 
     // TODO: this can be any `id`, even if it's not a valid entity id.
@@ -55,7 +120,368 @@ public:
      * @param id The ID of the Entity.
      * @return Entity
      */
-    microECS::Entity Entity(EntityID id) { return microECS::Entity(id, &m_Registry); }
+    BasicEntity<Traits> Entity(EntityID id) { return BasicEntity<Traits>(id, &m_Registry); }
+
+    /**
+     * @brief Creates `count` entities without components in one step.
+     *
+     * @param count The number of entities to create.
+     * @param out Receives the IDs of the new entities, must have room for `count` IDs.
+     * @return `false` if a fixed-capacity world has no room for them. Nothing is created then.
+     */
+    bool CreateEntities(size_t count, EntityID* out) {
+        return m_Registry.CreateEntities(count, out);
+    }
+
+    /**
+     * @brief Reserves an entity ID from any thread, without locking, also while the main
+     * thread uses the world. The entity exists once the main thread applies a command buffer
+     * or calls `FlushReservedEntities`; give it components through a `CommandBuffer`.
+     *
+     * @warning Do not reserve while the main thread clears the world, loads an image or
+     * applies a delta.
+     * @return The reserved ID, or `INVALID_ENTITY_ID` if a fixed-capacity world is full.
+     */
+    EntityID ReserveEntity() { return m_Registry.ReserveEntities(1); }
+
+    /**
+     * @brief Reserves `count` entity IDs at once from any thread, see `ReserveEntity`.
+     *
+     * @param count The number of IDs to reserve.
+     * @param out Receives the reserved IDs, must have room for `count` IDs.
+     * @return `false` if a fixed-capacity world has no room for them. Nothing is reserved then.
+     */
+    bool ReserveEntities(size_t count, EntityID* out) {
+        EntityID first = m_Registry.ReserveEntities(count);
+        if (first == Traits::INVALID_ENTITY_ID) {
+            return false;
+        }
+
+        for (size_t i = 0; i < count; i++) { out[i] = static_cast<EntityID>(first + i); }
+        return true;
+    }
+
+    /**
+     * @brief Turns every reserved ID into an entity without components. Main thread only.
+     */
+    void FlushReservedEntities() { m_Registry.FlushReservedEntities(); }
+
+    /**
+     * @brief Applies a command buffer recorded on another thread, then empties it.
+     * Reserved IDs become entities first. Main thread only.
+     *
+     * @param commands The commands to apply.
+     */
+    void Apply(CommandBuffer& commands) {
+        MECS_TRACE_SCOPE("World::Apply");
+        commands.Apply(m_Registry);
+    }
+
+    /**
+     * @brief Creates `count` entities that all start with a copy of each prototype component.
+     * IDs are reserved in one step and every pool grows at most once, then the dense
+     * arrays and entity maps are filled in a tight loop per component type.
+     *
+     * @tparam Ts The component types.
+     * @param count The number of entities to create.
+     * @param prototypes The initial value of each component.
+     * @return The IDs of the new entities, or no IDs if they do not fit in a fixed-capacity world.
+     */
+    template <typename... Ts>
+    std::vector<EntityID> CreateEntities(size_t count, const Ts&... prototypes) {
+        MECS_TRACE_SCOPE("World::CreateEntities");
+
+        if (count > m_Registry.GetRemainingEntityCapacity() ||
+            !(m_Registry.HasRoomFor(m_Registry.template GetComponentID<Ts>(), count) && ...)) {
+            return {};
+        }
+
+        // Another thread may reserve the last IDs between the check and the creation
+        std::vector<EntityID> entityIDs(count);
+        if (!m_Registry.CreateEntities(count, entityIDs.data())) {
+            return {};
+        }
+
+        (m_Registry.AddComponents(entityIDs.data(), count, m_Registry.template GetComponentID<Ts>(),
+                                  &prototypes),
+         ...);
+
+        return entityIDs;
+    }
+
+    /**
+     * @brief Builds the pool of `T` directly around an existing packed array, e.g. from an
+     * asset pipeline. Nothing is copied component by component: the data is copied with one
+     * memcpy, borrowed in place or adopted, and the entity index is built in bulk.
+     *
+     * @warning The pool of `T` must be empty.
+     *
+     * @tparam T The component type.
+     * @param entityIDs The entity owning each component, usually from `CreateEntities`.
+     * @param data `count` packed components.
+     * @param count The number of components.
+     * @param ownership Whether the data is copied, borrowed or adopted by the pool.
+     * @return `false` if the pool is fixed-capacity and the data does not fit or is not copied.
+     */
+    template <typename T>
+    bool ImportColumn(const EntityID* entityIDs, T* data, size_t count,
+                      Ownership ownership = Ownership::Copy) {
+        static_assert(!IS_SPLIT<T>, "Split components cannot be imported.");
+        return m_Registry.ImportComponents(m_Registry.template GetComponentID<T>(), entityIDs,
+                                           data, count, ownership);
+    }
+
+    /**
+     * @brief Returns the dense array of `T` and its entities without gathering anything,
+     * e.g. to hand it to a renderer.
+     *
+     * @tparam T The component type.
+     * @return A read-only view that is invalidated by structural changes to the pool.
+     */
+    template <typename T>
+    Column<T, Traits> ExportColumn() {
+        static_assert(!IS_SOA<T>, "SoA components have no packed column, use Field.");
+        static_assert(!IS_SHARED<T>, "Shared components have no packed column.");
+        ComponentID componentID = m_Registry.template GetComponentID<T>();
+        const Registry& registry = m_Registry;
+        return registry.GetComponentPool(componentID).template GetColumn<T>();
+    }
+
+    /**
+     * @brief Returns the column of one field of an SoA component, for systems that sweep a
+     * few fields of every component. Element `i` of every field of `T` belongs to the same
+     * entity, in the dense order of the pool.
+     *
+     * @code
+     * auto x = world.Field<&Particle::x>();
+     * auto vx = world.Field<&Particle::vx>();
+     * for (size_t i = 0; i < x.Size(); i++) { x[i] += vx[i]; }
+     * @endcode
+     *
+     * @tparam Member A pointer to a field listed in `SoAFields<T>`, e.g. `&Particle::x`.
+     * @return A span that is invalidated by structural changes to the pool.
+     */
+    template <auto Member>
+    FieldSpan<MemberType<Member>> Field() {
+        using T = typename MemberPointer<decltype(Member)>::Class;
+        constexpr size_t FIELD = SoAFields<T>::template IndexOf<Member>();
+        static_assert(IS_SOA<T> && FIELD < SoAFields<T>::COUNT,
+                      "The member is not a field of an SoA component.");
+
+        ComponentPool& pool = m_Registry.GetComponentPool(m_Registry.template GetComponentID<T>());
+        MECS_PROFILE(pool.RecordPass(pool.GetCount(), FIELD < 64 ? uint64_t(1) << FIELD : 0));
+        return FieldSpan<MemberType<Member>>(
+            static_cast<MemberType<Member>*>(pool.GetFieldData(FIELD)), pool.GetCount());
+    }
+
+    /**
+     * @brief Creates an empty prefab for this world.
+     * Add components to it with `Set` / `Add`, then spawn copies with `Instantiate`.
+     *
+     * @return The prefab.
+     */
+    BasicPrefab<Traits> Prefab() { return BasicPrefab<Traits>(&m_Registry); }
+
+    /**
+     * @brief Creates `count` entities from a prefab.
+     * Every component blob of the prefab is copied into its pool in one batched operation.
+     *
+     * @param prefab A prefab created by this world.
+     * @param count The number of entities to create.
+     * @param out Receives the IDs of the new entities, must have room for `count` IDs.
+     * @return `false` if the instances do not fit in a fixed-capacity world.
+     * Nothing is created then.
+     */
+    bool Instantiate(const BasicPrefab<Traits>& prefab, size_t count, EntityID* out) {
+        ASSERT(prefab.GetRegistry() == &m_Registry, "Prefab belongs to a different world.");
+        MECS_TRACE_SCOPE("World::Instantiate");
+
+        for (size_t i = 0; i < prefab.GetComponentCount(); i++) {
+            if (!m_Registry.HasRoomFor(prefab.GetComponentID(i), count)) {
+                return false;
+            }
+        }
+        if (!m_Registry.CreateEntities(count, out)) {
+            return false;
+        }
+
+        for (size_t i = 0; i < prefab.GetComponentCount(); i++) {
+            m_Registry.AddComponents(out, count, prefab.GetComponentID(i),
+                                     prefab.GetComponentData(i));
+        }
+        return true;
+    }
+
+    /**
+     * @brief Creates `count` entities from a prefab.
+     *
+     * @overload Instantiate(const Prefab& prefab, size_t count, EntityID* out)
+     * @return The IDs of the new entities, or no IDs if they do not fit.
+     */
+    std::vector<EntityID> Instantiate(const BasicPrefab<Traits>& prefab, size_t count) {
+        std::vector<EntityID> entityIDs(count);
+        if (!Instantiate(prefab, count, entityIDs.data())) {
+            entityIDs.clear();
+        }
+        return entityIDs;
+    }
+
+    /**
+     * @brief Destroys every entity that has all of the given components.
+     * Pools that lose all of their entities are cleared in O(pages) instead of
+     * removing the entities one by one.
+     *
+     * @tparam Ts The components an entity needs to have to be destroyed.
+     */
+    template <typename... Ts>
+    void DestroyAll() {
+        static_assert(sizeof...(Ts) > 0, "DestroyAll needs at least one component type.");
+
+        ComponentID componentIDs[] = { m_Registry.template GetComponentID<Ts>()... };
+        m_Registry.DestroyAll(componentIDs, sizeof...(Ts));
+    }
+
+    /**
+     * @brief Removes component `T` from every entity at once. The entities stay alive.
+     *
+     * @tparam T The component type.
+     * @param keepCapacity If `true`, the pool keeps its memory so refilling it does not reallocate.
+     */
+    template <typename T>
+    void Clear(bool keepCapacity = true) {
+        m_Registry.ClearComponentPool(m_Registry.template GetComponentID<T>(), keepCapacity);
+    }
+
+    /**
+     * @brief Destroys every entity in the world, e.g. when unloading a level.
+     * Component types stay registered and singleton components are kept.
+     *
+     * @param keepCapacity If `true`, pools keep their memory so the next level does not reallocate.
+     */
+    void Clear(bool keepCapacity = true) { m_Registry.Clear(keepCapacity); }
+
+    /**
+     * @brief Registers component types up front, creating their pools.
+     * In a fixed-capacity world this is where pools allocate, so call it at startup with
+     * every component type to keep the rest of the run allocation-free.
+     *
+     * @tparam Ts The component types.
+     */
+    template <typename... Ts>
+    void Register() {
+        (m_Registry.template GetComponentID<Ts>(), ...);
+    }
+
+    /**
+     * @brief Makes sure the pool of `T` can hold `capacity` components without growing,
+     * e.g. before spawning a wave of known size.
+     *
+     * @tparam T The component type.
+     * @param capacity The number of components to make room for.
+     * @return `false` if `capacity` is larger than the pool capacity of a fixed-capacity world.
+     */
+    template <typename T>
+    bool Reserve(size_t capacity) {
+        return m_Registry.Reserve(m_Registry.template GetComponentID<T>(), capacity);
+    }
+
+    /**
+     * @brief Sets how pools grow when they are full, for every pool including the ones
+     * created later. See `GrowthPolicy`; by default pools double.
+     *
+     * @param policy The growth policy.
+     */
+    void SetGrowthPolicy(const GrowthPolicy& policy) { m_Registry.SetGrowthPolicy(policy); }
+
+    /**
+     * @brief Sets the growth policy of the pool of `T` only.
+     *
+     * @tparam T The component type.
+     * @param policy The growth policy.
+     */
+    template <typename T>
+    void SetGrowthPolicy(const GrowthPolicy& policy) {
+        m_Registry.SetGrowthPolicy(m_Registry.template GetComponentID<T>(), policy);
+    }
+
+    /**
+     * @brief Marks the end of a frame. Pools with an adaptive `GrowthPolicy` use the adds
+     * counted between two calls to decide how far to grow; other pools ignore it.
+     */
+    void EndFrame() { m_Registry.EndFrame(); }
+
+    /**
+     * @brief Sets when pools give memory back after removals, for every pool including the
+     * ones created later. See `ShrinkPolicy`; by default pools never shrink on their own.
+     *
+     * @param policy The shrink policy.
+     */
+    void SetShrinkPolicy(const ShrinkPolicy& policy) { m_Registry.SetShrinkPolicy(policy); }
+
+    /**
+     * @brief Sets the shrink policy of the pool of `T` only.
+     *
+     * @tparam T The component type.
+     * @param policy The shrink policy.
+     */
+    template <typename T>
+    void SetShrinkPolicy(const ShrinkPolicy& policy) {
+        m_Registry.SetShrinkPolicy(m_Registry.template GetComponentID<T>(), policy);
+    }
+
+    /**
+     * @brief Sets which destroyed entity's ID the next created entity gets. See `ReusePolicy`;
+     * by default the ID that was freed first is reused first.
+     *
+     * @param policy The reuse policy.
+     */
+    void SetReusePolicy(ReusePolicy policy) { m_Registry.SetReusePolicy(policy); }
+
+    /**
+     * @brief Gives unused memory back right away, e.g. after a level or a large wave of
+     * entities is gone. Every pool shrinks to its live components, empty pages of the entity
+     * indices are freed, and the entity free list is trimmed.
+     */
+    void ShrinkToFit() { m_Registry.ShrinkToFit(); }
+
+    /**
+     * @brief Shrinks the pool of `T` to its live components.
+     *
+     * @tparam T The component type.
+     */
+    template <typename T>
+    void ShrinkToFit() {
+        m_Registry.GetComponentPool(m_Registry.template GetComponentID<T>()).ShrinkToFit();
+    }
+
+    /**
+     * @brief Checks if the world was created with a `WorldCapacity`.
+     */
+    bool IsFixedCapacity() const { return m_Registry.IsFixedCapacity(); }
+
+    /**
+     * @brief Returns how many more entities can be created.
+     */
+    size_t GetRemainingEntityCapacity() const { return m_Registry.GetRemainingEntityCapacity(); }
+
+    /**
+     * @brief Returns how many more `T` components fit without allocating.
+     * In a fixed-capacity world this is a hard limit.
+     *
+     * @tparam T The component type.
+     */
+    template <typename T>
+    size_t GetRemainingCapacity() {
+        const Registry& registry = m_Registry;
+        ComponentID componentID = m_Registry.template GetComponentID<T>();
+        return registry.GetComponentPool(componentID).GetRemainingCapacity();
+    }
+
+    /**
+     * @brief Returns the slab of a fixed-capacity world, e.g. to check how much of it is used,
+     * or nullptr for other worlds.
+     */
+    const SlabResource* GetSlab() const { return m_pSlab.get(); }
 
     /**
      * @brief Looks up an entity by its name.
@@ -63,22 +489,52 @@ public:
      * @param name The name of the entity to look up.
      * @return The entity with the specified name, or an invalid entity if not found.
      */
-    microECS::Entity Lookup(const std::string& name) {
-        return microECS::Entity(m_Registry.GetEntityIDByName(name), &m_Registry);
+    BasicEntity<Traits> Lookup(const std::string& name) {
+        return BasicEntity<Traits>(m_Registry.GetEntityIDByName(name), &m_Registry);
+    }
+
+    /**
+     * @brief Looks up an entity by a name hashed at compile time, see `HashedName`.
+     *
+     * @param name The name of the entity to look up, e.g. `"Player"_name`.
+     * @return The entity with the specified name, or an invalid entity if not found.
+     */
+    BasicEntity<Traits> Lookup(const HashedName& name) {
+        return BasicEntity<Traits>(m_Registry.GetEntityIDByName(name), &m_Registry);
     }
 
     // QUESTION: Should this be T&& component using std::move?
+    /**
+     * @brief Sets the singleton component `T`, overwriting its value if it already exists.
+     *
+     * @warning Setting a singleton of a new type may move the other singletons, so pointers
+     * from `Get` / `GetMut` should not be kept across it.
+     *
+     * @tparam T The component type.
+     * @param component The value of the singleton.
+     * @return The stored singleton.
+     */
     template <typename T>
     T& Set(const T& component) {
-        std::type_index typeIndex = typeid(T);
-        return *static_cast<T*>(
-            m_Registry.SetSingletonComponent(&component, typeid(T), sizeof(T), alignof(T)));
+        return *static_cast<T*>(m_Registry.SetSingletonComponent(
+            &component, SingletonStore::TypeID<T>(), sizeof(T), alignof(T)));
     }
 
+    /**
+     * @brief Returns the singleton component `T`, or nullptr if it was never set.
+     */
     template <typename T>
-    const T* Get() {
-        std::type_index typeIndex = typeid(T);
-        return static_cast<const T*>(m_Registry.GetSingletonComponent(typeIndex));
+    const T* Get() const {
+        return static_cast<const T*>(
+            m_Registry.GetSingletonComponent(SingletonStore::TypeID<T>()));
+    }
+
+    /**
+     * @brief Returns the singleton component `T` for writing, or nullptr if it was never set.
+     */
+    template <typename T>
+    T* GetMut() {
+        return static_cast<T*>(m_Registry.GetMutSingletonComponent(SingletonStore::TypeID<T>()));
     }
 
     /**
@@ -88,8 +544,8 @@ public:
      * @return A view of entities with the specified components.
      */
     template <typename... Components>
-    microECS::View<Components...> View() {
-        return microECS::View<Components...>(&m_Registry);
+    BasicView<Traits, Components...> View() {
+        return BasicView<Traits, Components...>(&m_Registry);
     }
 
     /**
@@ -106,7 +562,13 @@ public:
      */
     template <typename T>
     void Sort(const std::function<bool(const T&, const T&)>& compare) {
-        ComponentID componentID = m_Registry.GetComponentID<T>();
+        static_assert(!std::is_empty_v<T>, "Tags have no data to sort by.");
+        static_assert(!IS_SOA<T>, "SoA components cannot be sorted yet.");
+        static_assert(!IS_SPLIT<T>, "Split components cannot be sorted.");
+        static_assert(!IS_SHARED<T>, "Shared components cannot be sorted.");
+        MECS_TRACE_SCOPE("World::Sort");
+
+        ComponentID componentID = m_Registry.template GetComponentID<T>();
         ComponentPool& pool = m_Registry.GetComponentPool(componentID);
 
         // If pool is already sorted, return.
@@ -122,7 +584,233 @@ public:
         pool.SetSorted(true);
     }
 
+    /**
+     * @brief Saves the world into a world image that can be memory-mapped by `LoadImage`.
+     * Component columns are stored page-aligned, see `WorldImage.h` for the format.
+     *
+     * @param path The file to write.
+     * @return `true` on success, `false` otherwise.
+     */
+    bool SaveImage(const std::string& path) const { return m_Registry.SaveImage(path); }
+
+    /**
+     * @brief Loads a world image without copying the component data.
+     * Pools point directly into the mapped file and pages are faulted in on first access.
+     * With `MapMode::CopyOnWrite` writes stay private to this process. With `MapMode::ReadOnly`
+     * a pool is copied to owned memory before its first write.
+     *
+     * @warning Must be called on a World without entities.
+     *
+     * @param path The world image to map.
+     * @param mode Read-only or copy-on-write mapping.
+     * @return `true` on success, `false` if the file is missing or not a valid image.
+     */
+    bool LoadImage(const std::string& path, MapMode mode = MapMode::CopyOnWrite) {
+        return m_Registry.LoadImage(path, mode);
+    }
+
+    /**
+     * @brief Copies the component state of the world, to be used as the base of `Diff`.
+     *
+     * @return The snapshot.
+     */
+    WorldSnapshot Snapshot() const {
+        WorldSnapshot snapshot;
+        snapshot.nextEntityID = m_Registry.GetNextEntityID();
+        m_Registry.GetFreeEntities(snapshot.freeEntities);
+        snapshot.pools.resize(m_Registry.GetComponentPoolCount());
+        for (size_t i = 0; i < snapshot.pools.size(); i++) {
+            SnapshotPool(m_Registry.GetComponentPool(static_cast<ComponentID>(i)),
+                         snapshot.pools[i]);
+        }
+
+        return snapshot;
+    }
+
+    /**
+     * @brief Computes what changed in every pool since `previous` was taken.
+     * Added and removed entities are listed per pool, and components present in both are
+     * compared word by word to record only the modified byte ranges. Destroyed entities, and
+     * reused IDs that have no components, are found by comparing the free lists.
+     *
+     * @note Each pool is diffed independently by `DiffPool`, which can be called from
+     * multiple threads for different pools to compute the delta in parallel.
+     *
+     * @param previous A snapshot of this world.
+     * @return The changes, without the pools that did not change.
+     */
+    WorldDelta Diff(const WorldSnapshot& previous) const {
+        WorldDelta delta;
+        delta.nextEntityID = m_Registry.GetNextEntityID();
+        m_Registry.DiffEntities(previous.freeEntities, delta.created, delta.destroyed);
+
+        for (size_t i = 0; i < m_Registry.GetComponentPoolCount(); i++) {
+            PoolDelta poolDelta;
+            DiffPool(previous, i, poolDelta);
+            if (!poolDelta.Empty()) {
+                delta.pools.push_back(std::move(poolDelta));
+            }
+        }
+
+        return delta;
+    }
+
+    /**
+     * @brief Computes the change set of a single pool since `previous` was taken.
+     * Does not modify the world, so it is safe to call concurrently for different pools.
+     *
+     * @param previous A snapshot of this world.
+     * @param poolIndex The pool to diff, in `[0, GetComponentPoolCount())`.
+     * @param out The change set to fill.
+     */
+    void DiffPool(const WorldSnapshot& previous, size_t poolIndex, PoolDelta& out) const {
+        const PoolSnapshot* previousPool =
+            poolIndex < previous.pools.size() ? &previous.pools[poolIndex] : nullptr;
+        microECS::DiffPool(m_Registry.GetComponentPool(static_cast<ComponentID>(poolIndex)),
+                           previousPool, out);
+    }
+
+    /**
+     * @brief Returns the number of component pools, e.g. to split `DiffPool` calls over threads.
+     */
+    size_t GetComponentPoolCount() const { return m_Registry.GetComponentPoolCount(); }
+
+    /**
+     * @brief Applies a delta computed by `Diff` on another world.
+     * This world is expected to be in the state of the snapshot the delta was computed from.
+     *
+     * @param delta The changes to apply.
+     */
+    void ApplyDelta(const WorldDelta& delta) { m_Registry.ApplyDelta(delta); }
+
+    /**
+     * @brief Sets how many frames the rollback ring keeps. Clears all saved frames.
+     *
+     * @param frames The number of most recent frames that can be restored.
+     */
+    void ConfigureRollback(size_t frames) { m_Rollback.Configure(frames); }
+
+    /**
+     * @brief Marks the pool of `T` as "rollback", so it is saved by `SaveFrame`.
+     * The save buffers are allocated here, so saving does not allocate as long as the
+     * pool stays within `capacity` components.
+     *
+     * @tparam T The component type.
+     * @param capacity The number of components to preallocate for every saved frame.
+     */
+    template <typename T>
+    void MarkRollback(size_t capacity = INIT_COMPONENT_POOL_SIZE) {
+        ComponentID componentID = m_Registry.template GetComponentID<T>();
+        const Registry& registry = m_Registry;
+        m_Rollback.Track(componentID, registry.GetComponentPool(componentID), capacity);
+
+        // Both parts of a split must roll back together to stay in step
+        if constexpr (IS_SPLIT<T>) {
+            ComponentID partner = m_Registry.GetSplitPartner(componentID);
+            m_Rollback.Track(partner, registry.GetComponentPool(partner), capacity);
+        }
+    }
+
+    /**
+     * @brief Saves the dense arrays of all rollback pools into the ring as `frame`.
+     * Pools that did not change since the last save are not copied.
+     *
+     * @param frame The frame number, expected to increase by one per call.
+     */
+    void SaveFrame(uint64_t frame) {
+        MECS_TRACE_SCOPE("World::SaveFrame");
+
+        // Saving only reads, so shared (forked) pools are not duplicated
+        const Registry& registry = m_Registry;
+        m_Rollback.Save(frame, [&registry](ComponentID componentID) -> const ComponentPool& {
+            return registry.GetComponentPool(componentID);
+        });
+    }
+
+    /**
+     * @brief Restores all rollback pools to their state at `frame`.
+     *
+     * @param frame A frame saved with `SaveFrame` that is still in the ring.
+     * @return `false` if the frame is not available.
+     */
+    bool RestoreFrame(uint64_t frame) {
+        MECS_TRACE_SCOPE("World::RestoreFrame");
+
+        return m_Rollback.Restore(frame, [this](ComponentID componentID) -> ComponentPool& {
+            return m_Registry.GetComponentPool(componentID);
+        });
+    }
+
+    /**
+     * @brief Reports how much memory the world uses.
+     * For each pool: capacity, live count, bytes of dense data and of the entity index,
+     * high-water mark and number of resizes. Also reports the entity free list,
+     * the name table and the singleton components.
+     *
+     * @return The statistics.
+     */
+    WorldStats Stats() const { return m_Registry.GetStats(); }
+
+    /**
+     * @brief Reports how every pool was accessed since the counters were last reset: reads,
+     * writes, iterations and, for SoA components, which fields were used together. Large
+     * components whose fields are rarely used together are flagged as candidates for a
+     * `SplitComponent`. See `Profile.h`.
+     *
+     * @param largeComponentBytes Components at least this large can be flagged.
+     * @param cohesionThreshold Components are flagged if passes touch less than this share of
+     * their fields on average.
+     * @return The report, always empty when built without `MECS_ENABLE_PROFILE`.
+     */
+    microECS::AccessReport AccessReport(size_t largeComponentBytes = 64,
+                                        float cohesionThreshold = 0.5f) const {
+        return m_Registry.GetAccessReport(largeComponentBytes, cohesionThreshold);
+    }
+
+    /**
+     * @brief Zeroes the access counters of every pool, e.g. at the start of a profiled frame.
+     */
+    void ResetAccessCounters() const { m_Registry.ResetAccessCounters(); }
+
+    /**
+     * @brief Returns the memory resource the world allocates from.
+     */
+    std::pmr::memory_resource* GetMemoryResource() const { return m_Registry.GetMemoryResource(); }
+
+    /**
+     * @brief Writes all trace events recorded so far as Chrome `trace_event` JSON.
+     * Events come from every thread and every World in the process (see `Trace.h`).
+     *
+     * @param path The file to write.
+     * @return `true` on success, always `false` when built without `MECS_ENABLE_TRACE`.
+     */
+    bool DumpTrace(const std::string& path) const {
+#if defined(MECS_ENABLE_TRACE)
+        return Trace::WriteChromeJson(path);
+#else
+        (void)path;
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Creates a copy-on-write branch of this world, e.g. for speculative simulation.
+     * The fork shares every component pool with this world. A pool is duplicated only when
+     * either world first modifies it, so forking costs next to nothing and a branch pays
+     * only for the component types it actually touches.
+     *
+     * @note The rollback ring is not forked.
+     * @warning Component pointers and views obtained before the fork must not be used to write
+     * afterwards, as they may point into storage that is now shared.
+     *
+     * @return The forked world.
+     */
+    BasicWorld Fork() const { return BasicWorld(m_Registry); }
+
 private:
+    explicit BasicWorld(const Registry& registry)
+        : m_Registry(registry), m_Rollback(registry.GetMemoryResource()) {}
+
     template <typename T>
     int partition(ComponentPool& pool, int low, int high,
                   const std::function<bool(const T&, const T&)>& compare) {
@@ -154,6 +842,11 @@ private:
     }
 
 private:
+    // Owns the memory of a fixed-capacity world, so it is declared (and destroyed) around the rest
+    std::unique_ptr<SlabResource> m_pSlab;
     Registry m_Registry;
+    RollbackBuffer m_Rollback;
 };
+
+using World = BasicWorld<DefaultIDTraits>;
 } // namespace microECS
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace microECS {
+
+/**
+ * @brief On-disk layout of a baked World ("world image").
+ *
+ * All offsets are in bytes from the start of the file. Every component column starts on an
+ * `IMAGE_PAGE_SIZE` boundary and is padded up to the next one, so a ComponentPool can point
+ * its storage straight into a mapping of the file. The padding becomes spare capacity.
+ *
+ * @code
+ * ImageHeader
+ * ImagePool[poolCount]
+ * ImageEntityName[nameCount]
+ * EntityID freeList[freeCount]
+ * char strings[stringsSize]
+ * per pool: EntityID entities[count]      (dense index -> entity)
+ *           <pad to page> components      (count used out of capacity)
+ * @endcode
+ *
+ * EntityIDs are stored at the width of the World's `IDTraits` (`entityIDSize`), so an image
+ * only loads into a World with the same ID traits.
+ *
+ * @warning The format stores raw component bytes and `typeid(T).name()` for matching,
+ * so an image is only valid for binaries built with the same compiler and component layout.
+ */
+constexpr char IMAGE_MAGIC[4] = { 'M', 'E', 'C', 'S' };
+constexpr uint32_t IMAGE_VERSION = 2;
+constexpr uint64_t IMAGE_PAGE_SIZE = 4096;
+
+struct ImageHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t pageSize;
+    uint32_t poolCount;
+    uint64_t nextEntityID;
+    uint64_t poolTableOffset;
+    uint64_t namesOffset;
+    uint64_t nameCount;
+    uint64_t freeListOffset;
+    uint64_t freeCount;
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+    uint32_t entityIDSize; // Bytes per EntityID
+    uint32_t indexBits;    // Bits of an EntityID that hold its index, the rest is generation
+};
+
+struct ImagePool {
+    uint64_t nameOffset; // Into the string table
+    uint64_t nameLength;
+    uint64_t componentSize;
+    uint64_t alignment;
+    uint64_t count;
+    uint64_t capacity;
+    uint64_t entitiesOffset;
+    uint64_t componentsOffset; // Always a multiple of IMAGE_PAGE_SIZE
+};
+
+struct ImageEntityName {
+    uint64_t entityID;
+    uint64_t nameOffset; // Into the string table
+    uint64_t nameLength;
+};
+
+/**
+ * @brief Rounds `value` up to the next multiple of `alignment` (power of two).
+ */
+constexpr uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace microECS
@@ -5,10 +5,29 @@
 // ASSERT
 
 // All headers
+#include "core/Capacity.h"
+#include "core/Column.h"
+#include "core/CommandBuffer.h"
 #include "core/ComponentPool.h"
 #include "core/Entity.h"
+#include "core/FileMapping.h"
+#include "core/Memory.h"
+#include "core/NameIndex.h"
+#include "core/Policy.h"
+#include "core/Prefab.h"
+#include "core/Profile.h"
 #include "core/Registry.h"
+#include "core/Rollback.h"
+#include "core/Shared.h"
+#include "core/SingletonStore.h"
+#include "core/Snapshot.h"
+#include "core/SoA.h"
+#include "core/SparseIndex.h"
+#include "core/Split.h"
+#include "core/Stats.h"
+#include "core/Trace.h"
 #include "core/Type.h"
 #include "core/Types.h"
 #include "core/View.h"
-#include "core/World.h"
\ No newline at end of file
+#include "core/World.h"
+#include "core/WorldImage.h"
\ No newline at end of file
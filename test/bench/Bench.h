@@ -0,0 +1,226 @@
+#pragma once
+
+#include "PerfCounters.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace microECSBench {
+
+/**
+ * @brief Times the measured region of a benchmark.
+ * A benchmark does its setup, then wraps only the work it wants measured
+ * in `Start()` / `Stop()`. Calling them more than once accumulates.
+ * When hardware counters are enabled, they count exactly the same region.
+ */
+class Timer {
+public:
+    explicit Timer(PerfCounters* counters = nullptr) : m_pCounters(counters) {}
+
+    void Start() {
+        if (m_pCounters != nullptr) {
+            m_pCounters->Start();
+        }
+        m_Begin = std::chrono::steady_clock::now();
+    }
+
+    void Stop() {
+        auto end = std::chrono::steady_clock::now();
+        if (m_pCounters != nullptr) {
+            m_Counters.Add(m_pCounters->Stop());
+        }
+        m_Elapsed += std::chrono::duration<double, std::nano>(end - m_Begin).count();
+    }
+
+    double ElapsedNs() const { return m_Elapsed; }
+    const CounterValues& Counters() const { return m_Counters; }
+
+private:
+    PerfCounters* m_pCounters;
+    std::chrono::steady_clock::time_point m_Begin;
+    double m_Elapsed = 0.0;
+    CounterValues m_Counters;
+};
+
+/**
+ * @brief The measurement of one benchmark at one entity count.
+ */
+struct Result {
+    std::string name;
+    size_t entities = 0;
+    size_t repetitions = 0;
+    double minNs = 0.0;
+    double medianNs = 0.0;
+    CounterValues counters; // Of the median repetition
+
+    double NsPerEntity() const { return entities > 0 ? medianNs / entities : 0.0; }
+
+    double PerEntity(Counter counter) const {
+        return entities > 0 ? static_cast<double>(counters.value[counter]) / entities : 0.0;
+    }
+};
+
+using BenchmarkFunc = std::function<void(size_t entities, Timer& timer)>;
+
+struct Options {
+    std::vector<size_t> sizes = { 10000, 100000, 1000000 };
+    size_t repetitions = 5;
+    std::string filter;
+    std::string jsonPath;
+    bool perf = false;
+};
+
+/**
+ * @class Runner
+ * @brief Runs every registered benchmark at every entity count and reports the median
+ * of several repetitions as ns/entity, on stdout and optionally as JSON.
+ */
+class Runner {
+public:
+    explicit Runner(const Options& options) : m_Options(options) {}
+
+    void Add(const std::string& name, BenchmarkFunc func) {
+        m_Benchmarks.push_back({ name, std::move(func) });
+    }
+
+    void Run() {
+        PerfCounters counters;
+        if (m_Options.perf && !counters.Open()) {
+            std::fprintf(stderr, "Hardware counters are not available "
+                                 "(unsupported platform or perf_event_paranoid too high).\n");
+        }
+        PerfCounters* pCounters = counters.IsOpen() ? &counters : nullptr;
+
+        std::printf("%-28s %10s %12s %12s", "benchmark", "entities", "ns/entity", "total ms");
+        if (pCounters != nullptr) {
+            std::printf(" %10s %10s %10s %10s %10s", "cyc/ent", "ins/ent", "l1d/ent", "llc/ent",
+                        "br/ent");
+        }
+        std::printf("\n");
+
+        for (auto& benchmark : m_Benchmarks) {
+            if (!m_Options.filter.empty() &&
+                benchmark.name.find(m_Options.filter) == std::string::npos) {
+                continue;
+            }
+
+            for (size_t entities : m_Options.sizes) {
+                std::vector<std::pair<double, CounterValues>> samples;
+                for (size_t i = 0; i < m_Options.repetitions; i++) {
+                    Timer timer(pCounters);
+                    benchmark.func(entities, timer);
+                    samples.emplace_back(timer.ElapsedNs(), timer.Counters());
+                }
+                std::sort(samples.begin(), samples.end(),
+                          [](auto& a, auto& b) { return a.first < b.first; });
+
+                Result result;
+                result.name = benchmark.name;
+                result.entities = entities;
+                result.repetitions = samples.size();
+                result.minNs = samples.front().first;
+                result.medianNs = samples[samples.size() / 2].first;
+                result.counters = samples[samples.size() / 2].second;
+                m_Results.push_back(result);
+
+                std::printf("%-28s %10zu %12.3f %12.3f", result.name.c_str(), entities,
+                            result.NsPerEntity(), result.medianNs / 1e6);
+                if (pCounters != nullptr) {
+                    for (size_t c = 0; c < CounterCount; c++) {
+                        if (result.counters.valid[c]) {
+                            std::printf(" %10.3f", result.PerEntity(static_cast<Counter>(c)));
+                        } else {
+                            std::printf(" %10s", "n/a");
+                        }
+                    }
+                }
+                std::printf("\n");
+                std::fflush(stdout);
+            }
+        }
+    }
+
+    /**
+     * @brief Writes all results as JSON, so runs of different releases can be compared.
+     */
+    bool WriteJson(const std::string& path) const {
+        FILE* file = std::fopen(path.c_str(), "w");
+        if (file == nullptr) {
+            return false;
+        }
+
+        std::fprintf(file, "{\n  \"repetitions\": %zu,\n  \"results\": [\n", m_Options.repetitions);
+        for (size_t i = 0; i < m_Results.size(); i++) {
+            const Result& result = m_Results[i];
+            std::fprintf(file,
+                         "    { \"name\": \"%s\", \"entities\": %zu, \"ns_per_entity\": %.4f, "
+                         "\"median_ns\": %.1f, \"min_ns\": %.1f",
+                         result.name.c_str(), result.entities, result.NsPerEntity(),
+                         result.medianNs, result.minNs);
+            for (size_t c = 0; c < CounterCount; c++) {
+                if (result.counters.valid[c]) {
+                    std::fprintf(file, ", \"%s_per_entity\": %.4f", COUNTER_NAMES[c],
+                                 result.PerEntity(static_cast<Counter>(c)));
+                }
+            }
+            std::fprintf(file, " }%s\n", i + 1 < m_Results.size() ? "," : "");
+        }
+        std::fprintf(file, "  ]\n}\n");
+
+        return std::fclose(file) == 0;
+    }
+
+    const std::vector<Result>& GetResults() const { return m_Results; }
+
+private:
+    struct Benchmark {
+        std::string name;
+        BenchmarkFunc func;
+    };
+
+    Options m_Options;
+    std::vector<Benchmark> m_Benchmarks;
+    std::vector<Result> m_Results;
+};
+
+/**
+ * @brief Parses `--sizes 10000,100000`, `--reps N`, `--filter name`, `--json path`
+ * and `--perf` (hardware counters per entity, Linux only).
+ */
+inline bool ParseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--sizes") == 0 && hasValue) {
+            options.sizes.clear();
+            for (char* token = std::strtok(argv[++i], ","); token != nullptr;
+                 token = std::strtok(nullptr, ",")) {
+                options.sizes.push_back(std::strtoull(token, nullptr, 10));
+            }
+        } else if (std::strcmp(argv[i], "--reps") == 0 && hasValue) {
+            options.repetitions = std::max<size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--filter") == 0 && hasValue) {
+            options.filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--json") == 0 && hasValue) {
+            options.jsonPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--perf") == 0) {
+            options.perf = true;
+        } else {
+            std::fprintf(stderr,
+                         "usage: %s [--sizes 10000,100000,1000000] [--reps 5] [--filter name] "
+                         "[--json results.json] [--perf]\n",
+                         argv[0]);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace microECSBench
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace microECSBench {
+
+/**
+ * @brief The hardware events counted around a benchmark region.
+ */
+enum Counter : size_t {
+    Cycles = 0,
+    Instructions,
+    L1DMisses,
+    LLCMisses,
+    BranchMisses,
+    CounterCount
+};
+
+constexpr const char* COUNTER_NAMES[CounterCount] = { "cycles", "instructions", "l1d_misses",
+                                                      "llc_misses", "branch_misses" };
+
+/**
+ * @brief Counter values of one measured region. `valid[i]` is false for events the
+ * CPU or kernel could not count.
+ */
+struct CounterValues {
+    uint64_t value[CounterCount] = {};
+    bool valid[CounterCount] = {};
+
+    void Add(const CounterValues& other) {
+        for (size_t i = 0; i < CounterCount; i++) {
+            value[i] += other.value[i];
+            valid[i] = other.valid[i];
+        }
+    }
+};
+
+/**
+ * @class PerfCounters
+ * @brief Hardware performance counters through Linux `perf_event_open`.
+ *
+ * Each event is opened on its own (not as a group), so an event that is not supported
+ * does not take the others down with it. Counts are scaled by enabled/running time when
+ * the kernel had to multiplex them. User space only, so `perf_event_paranoid` <= 2 suffices.
+ * On other platforms, or without permission, `Open` returns `false` and nothing is counted.
+ */
+class PerfCounters {
+public:
+    PerfCounters() {
+        for (int& fd : m_Fds) { fd = -1; }
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    ~PerfCounters() { Close(); }
+
+    /**
+     * @brief Opens the counters for the calling thread.
+     *
+     * @return `true` if at least one counter could be opened.
+     */
+    bool Open() {
+#if defined(__linux__)
+        const uint64_t l1dMiss = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                 (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+        const struct {
+            uint32_t type;
+            uint64_t config;
+        } events[CounterCount] = {
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+            { PERF_TYPE_HW_CACHE, l1dMiss },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+        };
+
+        bool any = false;
+        for (size_t i = 0; i < CounterCount; i++) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = events[i].type;
+            attr.config = events[i].config;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            m_Fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            any |= m_Fds[i] >= 0;
+        }
+
+        return any;
+#else
+        return false;
+#endif
+    }
+
+    void Close() {
+#if defined(__linux__)
+        for (int& fd : m_Fds) {
+            if (fd >= 0) {
+                close(fd);
+                fd = -1;
+            }
+        }
+#endif
+    }
+
+    bool IsOpen() const {
+        for (int fd : m_Fds) {
+            if (fd >= 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Start() {
+#if defined(__linux__)
+        for (int fd : m_Fds) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    /**
+     * @brief Stops counting and returns the counts since `Start`.
+     */
+    CounterValues Stop() {
+        CounterValues values;
+#if defined(__linux__)
+        for (int fd : m_Fds) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+
+        for (size_t i = 0; i < CounterCount; i++) {
+            uint64_t data[3] = {}; // value, time enabled, time running
+            if (m_Fds[i] < 0 || read(m_Fds[i], data, sizeof(data)) != sizeof(data) ||
+                data[2] == 0) {
+                continue;
+            }
+
+            double scale = static_cast<double>(data[1]) / static_cast<double>(data[2]);
+            values.value[i] = static_cast<uint64_t>(static_cast<double>(data[0]) * scale);
+            values.valid[i] = true;
+        }
+#endif
+        return values;
+    }
+
+private:
+    int m_Fds[CounterCount];
+};
+
+} // namespace microECSBench
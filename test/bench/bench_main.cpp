@@ -0,0 +1,270 @@
+#include "Bench.h"
+#include "microECS.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using microECSBench::Timer;
+
+namespace {
+
+// Fixed seed so every run (and every release) benchmarks the same data
+constexpr uint32_t SEED = 0x5EED;
+
+struct Position {
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+};
+
+struct Velocity {
+    float dx = 0.0f;
+    float dy = 0.0f;
+    float dz = 0.0f;
+};
+
+struct Health {
+    int value = 100;
+};
+
+struct Gravity {
+    float value = -9.81f;
+};
+
+// A large component of which a system only touches a few fields
+struct Particle {
+    float x, y, z, vx, vy, vz, r, g, b, a, size, life;
+};
+
+// The same component stored as a structure of arrays
+struct SoAParticle {
+    float x, y, z, vx, vy, vz, r, g, b, a, size, life;
+};
+
+} // namespace
+
+MECS_SOA(SoAParticle, x, y, z, vx, vy, vz, r, g, b, a, size, life);
+
+namespace {
+
+// Keeps the optimizer from removing results
+volatile float g_Sink = 0.0f;
+
+void CreateEntities(size_t n, Timer& timer) {
+    microECS::World world;
+
+    timer.Start();
+    for (size_t i = 0; i < n; i++) { world.Entity(); }
+    timer.Stop();
+}
+
+void CreateEntitiesBulk(size_t n, Timer& timer) {
+    microECS::World world;
+    std::vector<microECS::EntityID> ids(n);
+
+    timer.Start();
+    world.CreateEntities(n, ids.data());
+    timer.Stop();
+}
+
+void CreateWithComponents(size_t n, Timer& timer) {
+    microECS::World world;
+
+    timer.Start();
+    for (size_t i = 0; i < n; i++) { world.Entity().Add<Position>().Add<Velocity>(); }
+    timer.Stop();
+}
+
+void CreateWithComponentsBulk(size_t n, Timer& timer) {
+    microECS::World world;
+
+    timer.Start();
+    world.CreateEntities(n, Position {}, Velocity {});
+    timer.Stop();
+}
+
+void DestroyEntities(size_t n, Timer& timer) {
+    microECS::World world;
+    std::vector<microECS::EntityID> ids = world.CreateEntities(n, Position {}, Velocity {});
+
+    timer.Start();
+    for (microECS::EntityID id : ids) { world.Entity(id).Destroy(); }
+    timer.Stop();
+}
+
+void AddRemoveChurn(size_t n, Timer& timer) {
+    microECS::World world;
+    std::vector<microECS::EntityID> ids = world.CreateEntities(n, Position {});
+
+    std::mt19937 rng(SEED);
+    std::shuffle(ids.begin(), ids.end(), rng);
+
+    timer.Start();
+    for (microECS::EntityID id : ids) { world.Entity(id).Add<Velocity>(); }
+    for (microECS::EntityID id : ids) { world.Entity(id).Remove<Velocity>(); }
+    timer.Stop();
+}
+
+void IterateOne(size_t n, Timer& timer) {
+    microECS::World world;
+    world.CreateEntities(n, Position {});
+
+    timer.Start();
+    world.View<Position>().Each([](microECS::EntityID, Position& position) {
+        position.x += 1.0f;
+    });
+    timer.Stop();
+}
+
+void IterateTwo(size_t n, Timer& timer) {
+    microECS::World world;
+    world.CreateEntities(n, Position {}, Velocity { 1.0f, 2.0f, 3.0f });
+
+    timer.Start();
+    world.View<Position, Velocity>().Each(
+        [](microECS::EntityID, Position& position, Velocity& velocity) {
+            position.x += velocity.dx;
+            position.y += velocity.dy;
+            position.z += velocity.dz;
+        });
+    timer.Stop();
+}
+
+// Moves every particle: reads 6 of the 12 fields, writes 3
+void ParticlesAoS(size_t n, Timer& timer) {
+    microECS::World world;
+    world.CreateEntities(n, Particle { 0, 0, 0, 1, 2, 3, 1, 1, 1, 1, 1, 1 });
+
+    timer.Start();
+    world.View<Particle>().Each([](microECS::EntityID, Particle& particle) {
+        particle.x += particle.vx;
+        particle.y += particle.vy;
+        particle.z += particle.vz;
+    });
+    timer.Stop();
+}
+
+void ParticlesSoA(size_t n, Timer& timer) {
+    microECS::World world;
+    world.CreateEntities(n, SoAParticle { 0, 0, 0, 1, 2, 3, 1, 1, 1, 1, 1, 1 });
+
+    timer.Start();
+    world.View<SoAParticle>().Each(
+        [](microECS::EntityID, microECS::SoARef<SoAParticle> particle) {
+            particle.Get<&SoAParticle::x>() += particle.Get<&SoAParticle::vx>();
+            particle.Get<&SoAParticle::y>() += particle.Get<&SoAParticle::vy>();
+            particle.Get<&SoAParticle::z>() += particle.Get<&SoAParticle::vz>();
+        });
+    timer.Stop();
+}
+
+void ParticlesSoAFields(size_t n, Timer& timer) {
+    microECS::World world;
+    world.CreateEntities(n, SoAParticle { 0, 0, 0, 1, 2, 3, 1, 1, 1, 1, 1, 1 });
+
+    timer.Start();
+    auto x = world.Field<&SoAParticle::x>();
+    auto y = world.Field<&SoAParticle::y>();
+    auto z = world.Field<&SoAParticle::z>();
+    auto vx = world.Field<&SoAParticle::vx>();
+    auto vy = world.Field<&SoAParticle::vy>();
+    auto vz = world.Field<&SoAParticle::vz>();
+    for (size_t i = 0; i < x.Size(); i++) {
+        x[i] += vx[i];
+        y[i] += vy[i];
+        z[i] += vz[i];
+    }
+    timer.Stop();
+}
+
+void RandomGet(size_t n, Timer& timer) {
+    microECS::World world;
+    std::vector<microECS::EntityID> ids = world.CreateEntities(n, Position { 1.0f, 2.0f, 3.0f });
+
+    std::mt19937 rng(SEED);
+    std::shuffle(ids.begin(), ids.end(), rng);
+
+    float sum = 0.0f;
+    timer.Start();
+    for (microECS::EntityID id : ids) {
+        const microECS::Entity entity = world.Entity(id);
+        sum += entity.Get<Position>()->y;
+    }
+    timer.Stop();
+    g_Sink = sum;
+}
+
+void Sort(size_t n, Timer& timer) {
+    microECS::World world;
+    std::vector<microECS::EntityID> ids = world.CreateEntities(n, Position {});
+
+    std::mt19937 rng(SEED);
+    std::uniform_real_distribution<float> distribution(-1000.0f, 1000.0f);
+    for (microECS::EntityID id : ids) { world.Entity(id).Get<Position>()->x = distribution(rng); }
+
+    timer.Start();
+    world.Sort<Position>([](const Position& a, const Position& b) { return a.x < b.x; });
+    timer.Stop();
+}
+
+/**
+ * A frame of three systems: integrate velocity, apply gravity, and tick health
+ * on a subset of the entities.
+ */
+void Frame(size_t n, Timer& timer) {
+    microECS::World world;
+    world.Set<Gravity>({});
+    std::vector<microECS::EntityID> ids = world.CreateEntities(n, Position {}, Velocity {});
+    for (size_t i = 0; i < n; i += 4) { world.Entity(ids[i]).Add<Health>(); }
+
+    timer.Start();
+    const float dt = 1.0f / 60.0f;
+    const float gravity = world.Get<Gravity>()->value;
+
+    world.View<Velocity>().Each([gravity, dt](microECS::EntityID, Velocity& velocity) {
+        velocity.dy += gravity * dt;
+    });
+    world.View<Position, Velocity>().Each(
+        [dt](microECS::EntityID, Position& position, Velocity& velocity) {
+            position.x += velocity.dx * dt;
+            position.y += velocity.dy * dt;
+            position.z += velocity.dz * dt;
+        });
+    world.View<Health>().Each([](microECS::EntityID, Health& health) { health.value -= 1; });
+    timer.Stop();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    microECSBench::Options options;
+    if (!microECSBench::ParseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    microECSBench::Runner runner(options);
+    runner.Add("create", CreateEntities);
+    runner.Add("create_bulk", CreateEntitiesBulk);
+    runner.Add("create_with_components", CreateWithComponents);
+    runner.Add("create_with_components_bulk", CreateWithComponentsBulk);
+    runner.Add("destroy", DestroyEntities);
+    runner.Add("add_remove_churn", AddRemoveChurn);
+    runner.Add("iterate_one", IterateOne);
+    runner.Add("iterate_two", IterateTwo);
+    runner.Add("particles_aos", ParticlesAoS);
+    runner.Add("particles_soa", ParticlesSoA);
+    runner.Add("particles_soa_fields", ParticlesSoAFields);
+    runner.Add("random_get", RandomGet);
+    runner.Add("sort", Sort);
+    runner.Add("frame_three_systems", Frame);
+    runner.Run();
+
+    if (!options.jsonPath.empty() && !runner.WriteJson(options.jsonPath)) {
+        std::fprintf(stderr, "Could not write %s\n", options.jsonPath.c_str());
+        return 1;
+    }
+
+    return 0;
+}
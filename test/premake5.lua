@@ -15,6 +15,12 @@ project "microECSTests"
         "./*.cpp",
     }
 
+    -- Tests run with tracing and profiling compiled in, so their tests exercise the real counters
+    defines { "MECS_ENABLE_TRACE", "MECS_ENABLE_PROFILE" }
+
+    filter "system:linux"
+        links "pthread"
+
     filter "configurations:Debug"
         defines "ENGINE_DEBUG"
         runtime "Debug"
@@ -24,3 +30,29 @@ project "microECSTests"
         defines "ENGINE_RELEASE"
         runtime "Release"
         optimize "on"
+
+    filter {}
+
+project "microECSBench"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++17"
+
+    includedirs {
+        "../microECS",
+    }
+
+    files {
+        "./bench/*.h",
+        "./bench/*.cpp",
+    }
+
+    filter "configurations:Debug"
+        defines "ENGINE_DEBUG"
+        runtime "Debug"
+        symbols "on"
+
+    filter "configurations:Release"
+        defines { "ENGINE_RELEASE", "NDEBUG" }
+        runtime "Release"
+        optimize "on"
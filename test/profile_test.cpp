@@ -0,0 +1,83 @@
+#include "catch2/catch.hpp"
+#include "microECS.h"
+
+#if defined(MECS_ENABLE_PROFILE)
+
+namespace {
+// 64 bytes, of which the movement system only uses two fields
+struct Particle {
+    float x = 0.0f, y = 0.0f, z = 0.0f, vx = 1.0f;
+    float vy = 0.0f, vz = 0.0f, r = 0.0f, g = 0.0f;
+    float b = 0.0f, a = 0.0f, size = 0.0f, life = 0.0f;
+    float age = 0.0f, spin = 0.0f, drag = 0.0f, seed = 0.0f;
+};
+} // namespace
+
+MECS_SOA(Particle, x, y, z, vx, vy, vz, r, g, b, a, size, life, age, spin, drag, seed);
+
+TEST_CASE("Access Profile", "[profile]") {
+    struct Health {
+        int value = 100;
+    };
+
+    microECS::World world;
+    std::vector<microECS::EntityID> ids = world.CreateEntities(50, Particle {}, Health {});
+
+    auto find = [](const microECS::AccessReport& report, const char* type) {
+        for (const microECS::PoolAccessStats& pool : report.pools) {
+            if (pool.name.find(type) != std::string::npos) {
+                return pool;
+            }
+        }
+        return microECS::PoolAccessStats();
+    };
+
+    world.ResetAccessCounters();
+    for (int frame = 0; frame < 4; frame++) {
+        world.View<Particle>().Each([](microECS::EntityID, microECS::SoARef<Particle> particle) {
+            particle.Get<&Particle::x>() += particle.Get<&Particle::vx>();
+        });
+    }
+    world.Field<&Particle::life>();
+    world.View<Health>().Each([](microECS::EntityID, Health& health) { health.value--; });
+    REQUIRE(world.Entity(ids[0]).Get<Health>()->value == 99);
+    world.Entity(ids[1]).Set(Health { 5 });
+
+    SECTION("Pools count reads, writes and passes") {
+        microECS::PoolAccessStats health = find(world.AccessReport(), "Health");
+        REQUIRE(health.counters.passes == 1);
+        REQUIRE(health.counters.iterations == 50);
+        REQUIRE(health.counters.writes == 2);
+        REQUIRE(health.fieldCount == 0);
+        REQUIRE(health.cohesion == 1.0f);
+        REQUIRE_FALSE(health.splitCandidate);
+    }
+
+    SECTION("SoA pools record the fields used together") {
+        microECS::AccessReport report = world.AccessReport();
+        microECS::PoolAccessStats particle = find(report, "Particle");
+        REQUIRE(particle.counters.passes == 5);
+        REQUIRE(particle.counters.iterations == 250);
+        REQUIRE(particle.counters.fieldGroups.size() == 2);
+        REQUIRE(particle.counters.fieldGroups[0].fields == 0b1001);
+        REQUIRE(particle.counters.fieldGroups[0].passes == 4);
+        REQUIRE(particle.hotFields == 0b1001);
+        REQUIRE(particle.cohesion < 0.5f);
+        REQUIRE(particle.splitCandidate);
+        REQUIRE(report.SplitCandidates().size() == 1);
+
+        // Smaller than the threshold, or using most fields every pass, is not flagged
+        REQUIRE_FALSE(find(world.AccessReport(128), "Particle").splitCandidate);
+        REQUIRE_FALSE(find(world.AccessReport(64, 0.1f), "Particle").splitCandidate);
+    }
+
+    SECTION("Counters can be reset") {
+        world.ResetAccessCounters();
+        microECS::PoolAccessStats particle = find(world.AccessReport(), "Particle");
+        REQUIRE(particle.counters.passes == 0);
+        REQUIRE(particle.counters.fieldGroups.empty());
+        REQUIRE_FALSE(particle.splitCandidate);
+    }
+}
+
+#endif
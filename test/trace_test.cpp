@@ -0,0 +1,51 @@
+#include "catch2/catch.hpp"
+#include "microECS.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#if defined(MECS_ENABLE_TRACE)
+
+TEST_CASE("Trace", "[trace]") {
+    struct Position {
+        float x = 0.0f;
+    };
+
+    const std::string path = "microecs_trace_test.json";
+
+    microECS::Trace::Clear();
+    microECS::World world;
+    world.CreateEntities(100, Position {});
+    world.View<Position>().Each([](microECS::EntityID, Position& position) { position.x += 1.0f; });
+    world.Sort<Position>([](const Position& a, const Position& b) { return a.x < b.x; });
+
+    std::thread worker([] { MECS_TRACE_SCOPE("Worker"); });
+    worker.join();
+
+    REQUIRE(world.DumpTrace(path));
+
+    std::ifstream file(path);
+    std::stringstream json;
+    json << file.rdbuf();
+
+    REQUIRE(json.str().find("\"traceEvents\"") != std::string::npos);
+    REQUIRE(json.str().find("\"name\":\"View::Each\",\"cat\":\"microECS\",\"ph\":\"B\"") !=
+            std::string::npos);
+    REQUIRE(json.str().find("\"name\":\"View::Each\",\"cat\":\"microECS\",\"ph\":\"E\"") !=
+            std::string::npos);
+    REQUIRE(json.str().find("ComponentPool::Resize") != std::string::npos);
+    REQUIRE(json.str().find("\"name\":\"Worker\"") != std::string::npos);
+
+    std::remove(path.c_str());
+}
+
+#else
+
+TEST_CASE("Trace disabled", "[trace]") {
+    microECS::World world;
+    REQUIRE_FALSE(world.DumpTrace("microecs_trace_test.json"));
+}
+
+#endif
@@ -2,6 +2,10 @@
 #include "catch2/catch.hpp"
 #include "microECS.h"
 
+#include <algorithm>
+#include <fstream>
+#include <thread>
+
 TEST_CASE("Entity Creation", "[world]") {
     microECS::World world;
 
@@ -34,6 +38,48 @@ TEST_CASE("Entity Lookup", "[world]") {
 
         REQUIRE(entity.GetID() == lookupEntity.GetID());
     }
+
+    SECTION("Lookup Entity by Compile-Time Hashed Name") {
+        using namespace microECS::literals;
+        constexpr microECS::HashedName player = "Player"_name;
+        static_assert(player.hash == microECS::HashName("Player", 6), "Hashed at compile time");
+
+        auto entity = world.Entity("Player");
+        REQUIRE(world.Lookup(player).GetID() == entity.GetID());
+        REQUIRE(world.Lookup("Enemy"_name).GetID() == microECS::INVALID_ENTITY_ID);
+    }
+
+    SECTION("Names Follow Their Entities") {
+        std::vector<microECS::EntityID> ids;
+        for (int i = 0; i < 1000; i++) {
+            ids.push_back(world.Entity("Entity" + std::to_string(i)).GetID());
+        }
+
+        REQUIRE(world.Entity("Entity500").GetID() == ids[500]);
+        REQUIRE(world.Entity(ids[999]).GetName() == "Entity999");
+
+        world.Entity(ids[10]).Destroy();
+        REQUIRE(world.Entity(ids[10]).GetName().empty());
+        REQUIRE(world.Lookup("Entity10").GetID() == microECS::INVALID_ENTITY_ID);
+        REQUIRE(world.Stats().nameCount == 999);
+
+        // The reused ID gets the new name only
+        auto renamed = world.Entity("Entity10b");
+        REQUIRE(renamed.GetID() == ids[10]);
+        REQUIRE(renamed.GetName() == "Entity10b");
+    }
+
+    SECTION("Unused Names Are Compacted") {
+        for (int i = 0; i < 20000; i++) {
+            world.Entity("Bullet" + std::to_string(i)).Destroy();
+        }
+        auto survivor = world.Entity("Survivor");
+
+        REQUIRE(world.Stats().nameCount == 1);
+        REQUIRE(world.Stats().nameBytes < 64 * 1024);
+        REQUIRE(world.Lookup("Survivor").GetID() == survivor.GetID());
+        REQUIRE(survivor.GetName() == "Survivor");
+    }
 }
 
 TEST_CASE("Singleton Components", "[world]") {
@@ -69,4 +115,1833 @@ TEST_CASE("Singleton Components", "[world]") {
         REQUIRE(time->value == 10.0f);
         REQUIRE(time->deltaTime == 0.1f);
     }
-}
\ No newline at end of file
+
+    SECTION("Overwrite and Mutate Singleton Component") {
+        struct Time {
+            float value = 0.0f;
+            float deltaTime = 0.0f;
+        };
+
+        REQUIRE(world.Get<Time>() == nullptr);
+        REQUIRE(world.GetMut<Time>() == nullptr);
+
+        world.Set<Time>({ 1.0f, 0.5f });
+        world.Set<Time>({ 2.0f, 0.25f });
+        REQUIRE(world.Get<Time>()->value == 2.0f);
+
+        world.GetMut<Time>()->value += 1.0f;
+        REQUIRE(world.Get<Time>()->value == 3.0f);
+        REQUIRE(world.Stats().singletonCount == 1);
+    }
+
+    SECTION("Singletons are copied with forks and freed with the world") {
+        struct Gravity {
+            float value = 9.81f;
+        };
+
+        struct alignas(32) Wind {
+            float direction[8] = {};
+        };
+
+        microECS::CountingResource memory;
+        {
+            microECS::World counted(&memory);
+            counted.Set<Gravity>({ 1.0f });
+            counted.Set<Wind>({});
+            REQUIRE(reinterpret_cast<uintptr_t>(counted.Get<Wind>()) % 32 == 0);
+            REQUIRE(counted.Get<Gravity>()->value == 1.0f);
+
+            microECS::World fork = counted.Fork();
+            fork.GetMut<Gravity>()->value = 2.0f;
+            REQUIRE(counted.Get<Gravity>()->value == 1.0f);
+            REQUIRE(fork.Get<Gravity>()->value == 2.0f);
+        }
+        REQUIRE(memory.GetBytesInUse() == 0);
+    }
+}
+TEST_CASE("World Image", "[world]") {
+    struct Position {
+        float x = 0.0f;
+        float y = 0.0f;
+    };
+
+    const std::string path = "microecs_world_image_test.bin";
+
+    {
+        microECS::World world;
+        for (int i = 0; i < 100; i++) {
+            world.Entity().Set<Position>({ static_cast<float>(i), static_cast<float>(-i) });
+        }
+        world.Entity("Player").Set<Position>({ 42.0f, 24.0f });
+
+        REQUIRE(world.SaveImage(path));
+    }
+
+    SECTION("Copy-on-write mapping") {
+        microECS::World world;
+        REQUIRE(world.LoadImage(path, microECS::MapMode::CopyOnWrite));
+
+        auto player = world.Lookup("Player");
+        REQUIRE(player.GetID() == 100);
+        REQUIRE(player.Get<Position>()->x == 42.0f);
+        REQUIRE(world.Entity(7).Get<Position>()->y == -7.0f);
+
+        // New entities keep counting from the saved state
+        REQUIRE(world.Entity().GetID() == 101);
+
+        // Growing past the mapped capacity promotes the pool to owned memory
+        for (int i = 0; i < 1000; i++) { world.Entity().Add<Position>(); }
+        REQUIRE(world.Entity(7).Get<Position>()->y == -7.0f);
+    }
+
+    SECTION("Read-only mapping") {
+        microECS::World world;
+        REQUIRE(world.LoadImage(path, microECS::MapMode::ReadOnly));
+
+        size_t count = 0;
+        world.View<Position>().Each([&count](microECS::EntityID, Position& position) {
+            position.x += 1.0f;
+            count++;
+        });
+
+        REQUIRE(count == 101);
+        REQUIRE(world.Lookup("Player").Get<Position>()->x == 43.0f);
+    }
+
+    SECTION("Importing into an empty mapped pool") {
+        struct Velocity {
+            float x = 0.0f;
+        };
+
+        const std::string empty = "microecs_empty_pool_image_test.bin";
+        {
+            microECS::World world;
+            world.Register<Velocity>();
+            REQUIRE(world.SaveImage(empty));
+        }
+
+        // The empty column is still mapped read-only, so the copy must go to owned memory
+        microECS::World world;
+        REQUIRE(world.LoadImage(empty, microECS::MapMode::ReadOnly));
+
+        std::vector<microECS::EntityID> ids(8);
+        world.CreateEntities(ids.size(), ids.data());
+        std::vector<Velocity> velocities(ids.size());
+        for (size_t i = 0; i < velocities.size(); i++) { velocities[i].x = float(i); }
+        REQUIRE(world.ImportColumn(ids.data(), velocities.data(), velocities.size()));
+        REQUIRE(world.Entity(ids[5]).Get<Velocity>()->x == 5.0f);
+
+        std::remove(empty.c_str());
+    }
+
+    SECTION("Invalid image") {
+        microECS::World world;
+        REQUIRE_FALSE(world.LoadImage("does_not_exist.bin"));
+    }
+
+    SECTION("Corrupted pool") {
+        struct Velocity {
+            float x = 1.0f;
+        };
+
+        const std::string corrupted = "microecs_corrupted_image_test.bin";
+        {
+            microECS::World world;
+            for (int i = 0; i < 10; i++) { world.Entity().Add<Position>().Add<Velocity>(); }
+            REQUIRE(world.SaveImage(corrupted));
+        }
+
+        // Point the column of the second pool past the end of the file
+        {
+            std::fstream file(corrupted, std::ios::binary | std::ios::in | std::ios::out);
+            microECS::ImageHeader header;
+            file.read(reinterpret_cast<char*>(&header), sizeof(header));
+            REQUIRE(header.poolCount == 2);
+
+            microECS::ImagePool pool;
+            std::streamoff at = static_cast<std::streamoff>(header.poolTableOffset) +
+                                static_cast<std::streamoff>(sizeof(microECS::ImagePool));
+            file.seekg(at);
+            file.read(reinterpret_cast<char*>(&pool), sizeof(pool));
+            pool.componentsOffset = microECS::IMAGE_PAGE_SIZE * 1000000;
+            file.seekp(at);
+            file.write(reinterpret_cast<const char*>(&pool), sizeof(pool));
+        }
+
+        // The first pool must not be left pointing into the released mapping
+        microECS::World world;
+        REQUIRE_FALSE(world.LoadImage(corrupted));
+        size_t count = 0;
+        world.View<Position>().Each([&count](microECS::EntityID, Position&) { count++; });
+        REQUIRE(count == 0);
+
+        world.Entity().Set<Position>({ 1.0f, 2.0f });
+        world.View<Position>().Each([&count](microECS::EntityID, Position&) { count++; });
+        REQUIRE(count == 1);
+
+        std::remove(corrupted.c_str());
+    }
+
+    SECTION("Overflowing pool record") {
+        const std::string corrupted = "microecs_overflow_image_test.bin";
+        {
+            microECS::World world;
+            for (int i = 0; i < 10; i++) { world.Entity().Add<Position>(); }
+            REQUIRE(world.SaveImage(corrupted));
+        }
+
+        auto patchPool = [&corrupted](auto patch) {
+            std::fstream file(corrupted, std::ios::binary | std::ios::in | std::ios::out);
+            microECS::ImageHeader header;
+            file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+            microECS::ImagePool pool;
+            std::streamoff at = static_cast<std::streamoff>(header.poolTableOffset);
+            file.seekg(at);
+            file.read(reinterpret_cast<char*>(&pool), sizeof(pool));
+            microECS::ImagePool saved = pool;
+            patch(pool);
+            file.seekp(at);
+            file.write(reinterpret_cast<const char*>(&pool), sizeof(pool));
+            return saved;
+        };
+        auto restorePool = [&patchPool](const microECS::ImagePool& saved) {
+            patchPool([&saved](microECS::ImagePool& pool) { pool = saved; });
+        };
+
+        // Sums and products that wrap around must not pass the bounds checks
+        microECS::ImagePool saved = patchPool([](microECS::ImagePool& pool) {
+            pool.nameOffset = ~uint64_t(0);
+            pool.nameLength = 2;
+        });
+        REQUIRE_FALSE(microECS::World().LoadImage(corrupted));
+
+        restorePool(saved);
+        patchPool([](microECS::ImagePool& pool) {
+            pool.componentSize = uint64_t(1) << 33;
+            pool.capacity = uint64_t(1) << 31;
+            pool.alignment = 8;
+        });
+        REQUIRE_FALSE(microECS::World().LoadImage(corrupted));
+
+        restorePool(saved);
+        patchPool([](microECS::ImagePool& pool) { pool.alignment = 3; });
+        REQUIRE_FALSE(microECS::World().LoadImage(corrupted));
+
+        // A registered component with another layout rejects the image
+        restorePool(saved);
+        patchPool([](microECS::ImagePool& pool) {
+            pool.componentSize *= 2;
+            pool.capacity /= 2;
+        });
+        {
+            microECS::World world;
+            world.Register<Position>();
+            REQUIRE_FALSE(world.LoadImage(corrupted));
+        }
+
+        restorePool(saved);
+        REQUIRE(microECS::World().LoadImage(corrupted));
+
+        std::remove(corrupted.c_str());
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Delta Snapshots", "[world]") {
+    struct Transform {
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+        int frame = 0;
+    };
+
+    microECS::World server;
+    microECS::World client;
+
+    for (int i = 0; i < 10; i++) {
+        server.Entity().Set<Transform>({ static_cast<float>(i), 0.0f, 0.0f, 0 });
+    }
+
+    // Initial sync against an empty snapshot
+    client.ApplyDelta(server.Diff(microECS::WorldSnapshot()));
+    REQUIRE(client.Entity(9).Get<Transform>()->x == 9.0f);
+
+    microECS::WorldSnapshot previous = server.Snapshot();
+
+    SECTION("No changes") {
+        REQUIRE(server.Diff(previous).pools.empty());
+        REQUIRE(server.Diff(previous).Empty());
+    }
+
+    SECTION("Destroyed and reused entities") {
+        server.Entity(5).Destroy();
+        server.Entity(6).Remove<Transform>();
+        server.Entity(6).Destroy();
+
+        std::vector<uint8_t> bytes;
+        server.Diff(previous).Serialize(bytes);
+        microECS::WorldDelta received;
+        REQUIRE(received.Deserialize(bytes.data(), bytes.size()));
+        REQUIRE(received.destroyed.size() == 2);
+        client.ApplyDelta(received);
+        REQUIRE_FALSE(client.Entity(5).IsValid());
+        REQUIRE_FALSE(client.Entity(6).IsValid());
+
+        // A reused ID without components only travels with the free lists
+        previous = server.Snapshot();
+        microECS::EntityID reused = server.Entity().GetID();
+        client.ApplyDelta(server.Diff(previous));
+        REQUIRE(client.Entity(reused).IsValid());
+        REQUIRE_FALSE(client.Entity(reused).Has<Transform>());
+
+        // Both free lists are in step, so both worlds hand out the same IDs next
+        REQUIRE(client.Entity().GetID() == server.Entity().GetID());
+        REQUIRE(client.Entity().GetID() == server.Entity().GetID());
+    }
+
+    SECTION("Modified, added and removed components") {
+        server.Entity(3).Get<Transform>()->y = 5.0f;
+        server.Entity(4).Remove<Transform>();
+        server.Entity().Set<Transform>({ 1.0f, 2.0f, 3.0f, 4 });
+
+        microECS::WorldDelta delta = server.Diff(previous);
+        REQUIRE(delta.pools.size() == 1);
+        REQUIRE(delta.pools[0].removed.size() == 1);
+        REQUIRE(delta.pools[0].added.size() == 1);
+
+        // Only the changed words of entity 3 are sent, entity 9 moved but did not change
+        REQUIRE(delta.pools[0].modified.size() == 1);
+        REQUIRE(delta.pools[0].modified[0].entityID == 3);
+        REQUIRE(delta.pools[0].modified[0].length <= sizeof(uint64_t));
+
+        std::vector<uint8_t> bytes;
+        delta.Serialize(bytes);
+
+        microECS::WorldDelta received;
+        REQUIRE(received.Deserialize(bytes.data(), bytes.size()));
+        client.ApplyDelta(received);
+
+        REQUIRE(client.Entity(3).Get<Transform>()->y == 5.0f);
+        REQUIRE_FALSE(client.Entity(4).Has<Transform>());
+        REQUIRE(client.Entity(10).Get<Transform>()->frame == 4);
+        REQUIRE(client.Entity(9).Get<Transform>()->x == 9.0f);
+    }
+
+    SECTION("Tags") {
+        struct Frozen {};
+        server.Entity(2).Add<Frozen>();
+        server.Entity().Add<Frozen>();
+
+        std::vector<uint8_t> bytes;
+        server.Diff(previous).Serialize(bytes);
+        microECS::WorldDelta received;
+        REQUIRE(received.Deserialize(bytes.data(), bytes.size()));
+        client.ApplyDelta(received);
+        REQUIRE(client.Entity(2).Has<Frozen>());
+        REQUIRE(client.Entity(10).Has<Frozen>());
+
+        previous = server.Snapshot();
+        server.Entity(2).Remove<Frozen>();
+        client.ApplyDelta(server.Diff(previous));
+        REQUIRE_FALSE(client.Entity(2).Has<Frozen>());
+        REQUIRE(client.Entity(10).Has<Frozen>());
+    }
+
+    SECTION("Truncated stream") {
+        server.Entity(1).Get<Transform>()->x = 100.0f;
+
+        std::vector<uint8_t> bytes;
+        server.Diff(previous).Serialize(bytes);
+
+        microECS::WorldDelta received;
+        REQUIRE_FALSE(received.Deserialize(bytes.data(), bytes.size() - 1));
+    }
+}
+
+TEST_CASE("Rollback", "[world]") {
+    struct Fighter {
+        int health = 100;
+        float x = 0.0f;
+    };
+
+    struct Stage {
+        int id = 0;
+    };
+
+    microECS::World world;
+    world.ConfigureRollback(8);
+    world.MarkRollback<Fighter>(16);
+    world.MarkRollback<Stage>(16);
+
+    auto p1 = world.Entity().Set<Fighter>({ 100, -1.0f });
+    auto p2 = world.Entity().Set<Fighter>({ 100, 1.0f });
+    world.Entity().Set<Stage>({ 3 });
+
+    // Simulate 20 frames, only the fighters change
+    for (uint64_t frame = 0; frame < 20; frame++) {
+        world.SaveFrame(frame);
+        p1.Get<Fighter>()->x += 1.0f;
+        p2.Get<Fighter>()->health -= 1;
+    }
+
+    SECTION("Restore a recent frame") {
+        REQUIRE(world.RestoreFrame(15));
+        REQUIRE(p1.Get<Fighter>()->x == 14.0f);
+        REQUIRE(p2.Get<Fighter>()->health == 85);
+        REQUIRE(world.Entity(2).Get<Stage>()->id == 3);
+    }
+
+    SECTION("Frames older than the ring are gone") {
+        REQUIRE_FALSE(world.RestoreFrame(11));
+        REQUIRE(world.RestoreFrame(12));
+    }
+
+    SECTION("Restore rewinds membership") {
+        world.SaveFrame(20);
+        p1.Remove<Fighter>();
+        world.Entity().Set<Fighter>({ 1, 0.0f });
+
+        REQUIRE(world.RestoreFrame(20));
+        REQUIRE(p1.Has<Fighter>());
+        REQUIRE_FALSE(world.Entity(3).Has<Fighter>());
+        REQUIRE(p1.Get<Fighter>()->x == 19.0f);
+    }
+
+    SECTION("Resimulating after a restore") {
+        REQUIRE(world.RestoreFrame(16));
+        for (uint64_t frame = 16; frame < 30; frame++) {
+            world.SaveFrame(frame);
+            p1.Get<Fighter>()->x += 2.0f;
+        }
+
+        REQUIRE(world.RestoreFrame(25));
+        REQUIRE(p1.Get<Fighter>()->x == 15.0f + 2.0f * 9);
+        REQUIRE(world.Entity(2).Get<Stage>()->id == 3);
+    }
+}
+
+TEST_CASE("World Fork", "[world]") {
+    struct Position {
+        float x = 0.0f;
+    };
+
+    struct Health {
+        int value = 100;
+    };
+
+    struct Gravity {
+        float value = 9.81f;
+    };
+
+    microECS::World world;
+    for (int i = 0; i < 100; i++) {
+        world.Entity().Set<Position>({ static_cast<float>(i) }).Set<Health>({ i });
+    }
+    world.Set<Gravity>({ 9.81f });
+
+    microECS::World branch = world.Fork();
+
+    SECTION("Branch sees the parent state") {
+        REQUIRE(branch.Entity(42).Get<Position>()->x == 42.0f);
+        REQUIRE(branch.Get<Gravity>()->value == 9.81f);
+    }
+
+    SECTION("Writes stay in their own world") {
+        branch.Entity(1).Get<Position>()->x = -1.0f;
+        branch.Entity(2).Remove<Health>();
+        world.Entity(3).Get<Health>()->value = 0;
+
+        REQUIRE(world.Entity(1).Get<Position>()->x == 1.0f);
+        REQUIRE(world.Entity(2).Has<Health>());
+        REQUIRE(branch.Entity(3).Get<Health>()->value == 3);
+        REQUIRE(branch.Entity(1).Get<Position>()->x == -1.0f);
+    }
+
+    SECTION("Views in a branch do not touch the parent") {
+        branch.View<Position>().Each([](microECS::EntityID, Position& position) {
+            position.x = 0.0f;
+        });
+
+        REQUIRE(world.Entity(99).Get<Position>()->x == 99.0f);
+    }
+
+    SECTION("Read-only views in a branch do not copy pools") {
+        struct Frozen {};
+        struct Visible {};
+
+        microECS::CountingResource memory;
+        microECS::World counted(&memory);
+        for (int i = 0; i < 100; i++) { counted.Entity().Add<Frozen>().Add<Visible>(); }
+        microECS::World fork = counted.Fork();
+        const size_t allocations = memory.GetAllocationCount();
+
+        size_t count = 0;
+        fork.View<Frozen>().Each([&count](microECS::EntityID) { count++; });
+        fork.View<Frozen, Visible>().Each([&count](microECS::EntityID) { count++; });
+        REQUIRE(count == 200);
+        REQUIRE(memory.GetAllocationCount() == allocations);
+    }
+
+    SECTION("Branch outlives the parent") {
+        microECS::World child = branch.Fork();
+        branch = microECS::World();
+        REQUIRE(child.Entity(50).Get<Health>()->value == 50);
+    }
+}
+
+TEST_CASE("Bulk Entity Creation", "[world]") {
+    struct Projectile {
+        float speed = 0.0f;
+    };
+
+    struct Damage {
+        int value = 0;
+    };
+
+    microECS::World world;
+
+    SECTION("Without components") {
+        microECS::EntityID ids[16];
+        world.CreateEntities(16, ids);
+
+        for (size_t i = 0; i < 16; i++) { REQUIRE(ids[i] == i); }
+        REQUIRE(world.Entity().GetID() == 16);
+    }
+
+    SECTION("With prototype components") {
+        world.Entity().Add<Damage>();
+
+        std::vector<microECS::EntityID> ids =
+            world.CreateEntities(10000, Projectile { 12.5f }, Damage { 3 });
+
+        REQUIRE(ids.size() == 10000);
+        REQUIRE(world.Entity(ids[9999]).Get<Projectile>()->speed == 12.5f);
+        REQUIRE(world.Entity(ids[0]).Get<Damage>()->value == 3);
+        REQUIRE_FALSE(world.Entity(0).Has<Projectile>());
+
+        size_t count = 0;
+        world.View<Projectile, Damage>().Each(
+            [&count](microECS::EntityID, Projectile&, Damage&) { count++; });
+        REQUIRE(count == 10000);
+    }
+}
+
+TEST_CASE("Bulk Destroy and Clear", "[world]") {
+    struct Projectile {
+        float speed = 0.0f;
+    };
+
+    struct Position {
+        float x = 0.0f;
+    };
+
+    microECS::World world;
+    auto player = world.Entity("Player").Set<Position>({ 1.0f });
+    world.CreateEntities(1000, Projectile { 1.0f }, Position { 2.0f });
+
+    SECTION("Destroy every entity with a component") {
+        world.DestroyAll<Projectile>();
+
+        REQUIRE(player.Has<Position>());
+        REQUIRE(player.Get<Position>()->x == 1.0f);
+        REQUIRE(world.Lookup("Player").GetID() == player.GetID());
+
+        size_t count = 0;
+        world.View<Position>().Each([&count](microECS::EntityID, Position&) { count++; });
+        REQUIRE(count == 1);
+
+        // Destroyed IDs are reused
+        REQUIRE(world.Entity().GetID() <= 1000);
+    }
+
+    SECTION("Destroy in several batches") {
+        world.DestroyAll<Projectile>();
+
+        // The new entities reuse the indices of the first batch, which must not count as
+        // destroyed again
+        world.CreateEntities(500, Position { 3.0f });
+        world.CreateEntities(600, Projectile { 1.0f });
+        world.DestroyAll<Projectile>();
+
+        size_t count = 0;
+        world.View<Position>().Each([&count](microECS::EntityID, Position&) { count++; });
+        REQUIRE(count == 501);
+        REQUIRE(player.Get<Position>()->x == 1.0f);
+    }
+
+    SECTION("Destroy a single entity") {
+        player.Destroy();
+        REQUIRE_FALSE(player.Has<Position>());
+        REQUIRE(world.Lookup("Player").GetID() == microECS::INVALID_ENTITY_ID);
+    }
+
+    SECTION("Clear a single component") {
+        world.Clear<Projectile>();
+
+        REQUIRE_FALSE(world.Entity(1).Has<Projectile>());
+        REQUIRE(world.Entity(1).Has<Position>());
+
+        world.Entity(1).Add<Projectile>();
+        REQUIRE(world.Entity(1).Has<Projectile>());
+    }
+
+    SECTION("Clear the whole world") {
+        world.Clear(false);
+
+        REQUIRE_FALSE(player.Has<Position>());
+        REQUIRE(world.Entity().GetID() == 0);
+    }
+
+    SECTION("Clearing a fork leaves the parent intact") {
+        microECS::World branch = world.Fork();
+        branch.Clear();
+
+        REQUIRE(world.Entity(500).Has<Projectile>());
+        REQUIRE_FALSE(branch.Entity(500).Has<Projectile>());
+    }
+}
+
+TEST_CASE("Prefabs", "[world]") {
+    struct Health {
+        int value = 100;
+    };
+
+    struct Speed {
+        double value = 0.0;
+    };
+
+    microECS::World world;
+    microECS::Prefab enemy = world.Prefab();
+    enemy.Add<Health>().Set<Speed>({ 4.5 });
+
+    SECTION("Instantiate many") {
+        std::vector<microECS::EntityID> ids = world.Instantiate(enemy, 1000);
+
+        REQUIRE(ids.size() == 1000);
+        for (microECS::EntityID id : ids) {
+            REQUIRE(world.Entity(id).Get<Health>()->value == 100);
+            REQUIRE(world.Entity(id).Get<Speed>()->value == 4.5);
+        }
+    }
+
+    SECTION("Changing the prefab only affects new instances") {
+        std::vector<microECS::EntityID> first = world.Instantiate(enemy, 3);
+        enemy.Set<Health>({ 50 }).Remove<Speed>();
+        std::vector<microECS::EntityID> second = world.Instantiate(enemy, 3);
+
+        REQUIRE(world.Entity(first[0]).Get<Health>()->value == 100);
+        REQUIRE(world.Entity(second[2]).Get<Health>()->value == 50);
+        REQUIRE_FALSE(world.Entity(second[2]).Has<Speed>());
+    }
+}
+
+TEST_CASE("Column Import and Export", "[world]") {
+    struct Bounds {
+        float min = 0.0f;
+        float max = 0.0f;
+    };
+
+    microECS::World world;
+    std::vector<microECS::EntityID> ids(64);
+    world.CreateEntities(ids.size(), ids.data());
+
+    std::vector<Bounds> bounds(ids.size());
+    for (size_t i = 0; i < bounds.size(); i++) {
+        bounds[i] = { static_cast<float>(i), static_cast<float>(i + 1) };
+    }
+
+    SECTION("Copy") {
+        world.ImportColumn(ids.data(), bounds.data(), bounds.size());
+        bounds[5].min = -1.0f;
+
+        REQUIRE(world.Entity(ids[5]).Get<Bounds>()->min == 5.0f);
+    }
+
+    SECTION("Borrow") {
+        world.ImportColumn(ids.data(), bounds.data(), bounds.size(), microECS::Ownership::Borrow);
+        bounds[5].min = -1.0f;
+        REQUIRE(world.Entity(ids[5]).Get<Bounds>()->min == -1.0f);
+
+        // Growing moves the pool into its own memory
+        world.Entity().Set<Bounds>({ 1.0f, 2.0f });
+        bounds[6].min = -1.0f;
+        REQUIRE(world.Entity(ids[6]).Get<Bounds>()->min == 6.0f);
+    }
+
+    SECTION("Adopt") {
+        void* buffer = ::operator new(sizeof(Bounds) * bounds.size(),
+                                      std::align_val_t(alignof(Bounds)));
+        std::memcpy(buffer, bounds.data(), sizeof(Bounds) * bounds.size());
+        world.ImportColumn(ids.data(), static_cast<Bounds*>(buffer), bounds.size(),
+                           microECS::Ownership::Adopt);
+
+        REQUIRE(world.Entity(ids[63]).Get<Bounds>()->max == 64.0f);
+    }
+
+    SECTION("Export") {
+        world.ImportColumn(ids.data(), bounds.data(), bounds.size());
+        microECS::Column<Bounds> column = world.ExportColumn<Bounds>();
+
+        REQUIRE(column.Size() == 64);
+        float sum = 0.0f;
+        for (const Bounds& b : column) { sum += b.min; }
+        REQUIRE(sum == 63.0f * 64.0f / 2.0f);
+        REQUIRE(column.Entities()[10] == ids[10]);
+    }
+}
+
+TEST_CASE("World Stats", "[world]") {
+    struct Position {
+        float x = 0.0f;
+        float y = 0.0f;
+    };
+
+    microECS::World world;
+    world.Entity("Named").Add<Position>();
+    world.CreateEntities(99, Position {});
+    world.Entity(5).Destroy();
+
+    microECS::WorldStats stats = world.Stats();
+    REQUIRE(stats.pools.size() == 1);
+
+    const microECS::PoolStats& pool = stats.pools[0];
+    REQUIRE(pool.count == 99);
+    REQUIRE(pool.highWaterMark == 100);
+    REQUIRE(pool.capacity >= 100);
+    REQUIRE(pool.resizeCount == 1);
+    REQUIRE(pool.denseBytes == pool.capacity * sizeof(Position));
+    REQUIRE(pool.indexBytes > 0);
+
+    REQUIRE(stats.entityCount == 99);
+    REQUIRE(stats.freeEntityCount == 1);
+    REQUIRE(stats.nameCount == 1);
+    REQUIRE(stats.TotalBytes() > pool.denseBytes);
+}
+
+TEST_CASE("Memory Resource", "[world]") {
+    struct Position {
+        float x = 0.0f;
+        float y = 0.0f;
+    };
+
+    struct Gravity {
+        float value = -9.81f;
+    };
+
+    microECS::CountingResource memory(std::pmr::new_delete_resource());
+
+    // Anything the world allocates outside of its resource would throw
+    std::pmr::memory_resource* previous =
+        std::pmr::set_default_resource(std::pmr::null_memory_resource());
+    {
+        microECS::World world(&memory);
+        REQUIRE(world.GetMemoryResource() == &memory);
+
+        world.Entity("A rather long entity name that does not fit in SSO").Add<Position>();
+        world.Set<Gravity>({});
+        std::vector<microECS::EntityID> ids = world.CreateEntities(5000, Position { 1.0f, 2.0f });
+        REQUIRE(memory.GetAllocationCount() > 0);
+
+        world.ConfigureRollback(2);
+        world.MarkRollback<Position>(8000);
+        world.SaveFrame(0);
+
+        microECS::World fork = world.Fork();
+        fork.Entity(ids[0]).Get<Position>()->x = 5.0f;
+
+        world.DestroyAll<Position>();
+        REQUIRE(world.RestoreFrame(0));
+
+        microECS::Prefab prefab = world.Prefab();
+        prefab.Add<Position>();
+
+        memory.ResetCounters();
+        world.View<Position>().Each(
+            [](microECS::EntityID, Position& position) { position.x += 1.0f; });
+        REQUIRE(memory.GetAllocationCount() == 0);
+        REQUIRE(memory.GetPeakBytes() == memory.GetBytesInUse());
+    }
+    std::pmr::set_default_resource(previous);
+
+    REQUIRE(memory.GetBytesInUse() == 0);
+    REQUIRE(memory.GetDeallocationCount() > 0);
+}
+
+namespace {
+struct Team {
+    uint32_t id = 0;
+    float color[3] = {};
+};
+} // namespace
+
+MECS_SHARED(Team);
+
+TEST_CASE("Fixed Capacity World", "[world]") {
+    struct Position {
+        float x = 0.0f;
+        float y = 0.0f;
+    };
+
+    struct Velocity {
+        float dx = 1.0f;
+    };
+
+    microECS::CountingResource memory(std::pmr::new_delete_resource());
+    microECS::World world(microECS::WorldCapacity::For<Position, Velocity>(100, 50), &memory);
+    world.Register<Position, Velocity>();
+
+    REQUIRE(world.IsFixedCapacity());
+    REQUIRE(world.GetRemainingEntityCapacity() == 100);
+    REQUIRE(world.GetRemainingCapacity<Position>() == 50);
+    REQUIRE(memory.GetAllocationCount() == 1);
+
+    const size_t setupBytes = world.GetSlab()->GetUsedBytes();
+    REQUIRE(setupBytes <= world.GetSlab()->GetSize());
+
+    SECTION("Limits") {
+        REQUIRE(world.CreateEntities(50, Position {}).size() == 50);
+        REQUIRE(world.GetRemainingCapacity<Position>() == 0);
+
+        microECS::Entity extra = world.Entity();
+        extra.Add<Position>();
+        REQUIRE_FALSE(extra.Has<Position>());
+
+        REQUIRE(world.CreateEntities(50, Velocity {}).empty());
+        REQUIRE(world.GetRemainingEntityCapacity() == 49);
+        REQUIRE(world.CreateEntities(49, Velocity {}).size() == 49);
+        REQUIRE(world.GetRemainingEntityCapacity() == 0);
+        REQUIRE(world.Entity().GetID() == microECS::INVALID_ENTITY_ID);
+
+        microECS::EntityID id;
+        REQUIRE_FALSE(world.CreateEntities(1, &id));
+    }
+
+    SECTION("Churn does not allocate") {
+        for (int frame = 0; frame < 10; frame++) {
+            std::vector<microECS::EntityID> ids = world.CreateEntities(40, Position {});
+            REQUIRE(ids.size() == 40);
+            for (size_t i = 0; i < ids.size(); i += 2) { world.Entity(ids[i]).Add<Velocity>(); }
+            world.View<Position, Velocity>().Each(
+                [](microECS::EntityID, Position& position, Velocity& velocity) {
+                    position.x += velocity.dx;
+                });
+
+            world.Entity(ids[0]).Remove<Velocity>().Destroy();
+            world.DestroyAll<Velocity>();
+            world.Clear<Position>(false);
+            world.Clear(false);
+        }
+
+        REQUIRE(world.GetRemainingEntityCapacity() == 100);
+        REQUIRE(world.GetRemainingCapacity<Position>() == 50);
+        REQUIRE(world.GetSlab()->GetUsedBytes() == setupBytes);
+        REQUIRE(memory.GetAllocationCount() == 1);
+    }
+
+    SECTION("Grouping shared components does not allocate") {
+        microECS::CountingResource teamMemory(std::pmr::new_delete_resource());
+        microECS::World teams(microECS::WorldCapacity::For<Team>(1000, 1000), &teamMemory);
+        std::vector<microECS::EntityID> ids = teams.CreateEntities(1000, Team {});
+        for (size_t i = 0; i < ids.size(); i++) {
+            teams.Entity(ids[i]).Set(Team { static_cast<uint32_t>(i % 8), {} });
+        }
+
+        auto groups = [&teams]() {
+            size_t count = 0;
+            teams.View<Team>().EachGroup(
+                [&count](const Team&, const microECS::EntityID*, size_t) { count++; });
+            return count;
+        };
+
+        REQUIRE(groups() == 8);
+        const size_t usedBytes = teams.GetSlab()->GetUsedBytes();
+        size_t total = 0;
+        for (int frame = 0; frame < 100; frame++) { total += groups(); }
+        REQUIRE(total == 800);
+        REQUIRE(teams.GetSlab()->GetUsedBytes() == usedBytes);
+        REQUIRE(teamMemory.GetAllocationCount() == 1);
+    }
+
+    SECTION("Grouping a full world of distinct shared values") {
+        // No headroom: the slab holds only what the capacity budgets for
+        constexpr size_t COUNT = 20000;
+        microECS::World teams(microECS::WorldCapacity::For<Team>(COUNT, COUNT, 0));
+        std::vector<microECS::EntityID> ids = teams.CreateEntities(COUNT, Team {});
+        REQUIRE(ids.size() == COUNT);
+        for (size_t i = 0; i < ids.size(); i++) {
+            teams.Entity(ids[i]).Set(Team { static_cast<uint32_t>(i), {} });
+        }
+        // Every value is in use, so the new one is stored before the old one is released
+        teams.Entity(ids[0]).Set(Team { static_cast<uint32_t>(COUNT), {} });
+
+        size_t groups = 0;
+        teams.View<Team>().EachGroup(
+            [&groups](const Team&, const microECS::EntityID*, size_t) { groups++; });
+        REQUIRE(groups == COUNT);
+        REQUIRE(teams.GetSlab()->GetUsedBytes() <= teams.GetSlab()->GetSize());
+    }
+
+    SECTION("Patching shared components does not allocate") {
+        microECS::World server;
+        std::vector<microECS::EntityID> ids = server.CreateEntities(1000, Team {});
+        for (size_t i = 0; i < ids.size(); i++) {
+            server.Entity(ids[i]).Set(Team { static_cast<uint32_t>(i % 8), {} });
+        }
+
+        microECS::CountingResource teamMemory(std::pmr::new_delete_resource());
+        microECS::World client(microECS::WorldCapacity::For<Team>(1000, 1000), &teamMemory);
+        client.ApplyDelta(server.Diff(microECS::WorldSnapshot()));
+        client.Register<Team>();
+
+        // Every frame each entity moves on to the next of the same 8 values
+        auto frame = [&]() {
+            microECS::WorldSnapshot previous = server.Snapshot();
+            for (microECS::EntityID id : ids) {
+                server.Entity(id).Set(Team { (server.Entity(id).Get<Team>()->id + 1) % 8, {} });
+            }
+            client.ApplyDelta(server.Diff(previous));
+        };
+
+        frame();
+        const size_t usedBytes = client.GetSlab()->GetUsedBytes();
+        for (int i = 0; i < 20; i++) { frame(); }
+        REQUIRE(client.GetSlab()->GetUsedBytes() == usedBytes);
+        REQUIRE(teamMemory.GetAllocationCount() == 1);
+        REQUIRE(client.Stats().pools[0].sharedValueCount == 8);
+        REQUIRE(client.Entity(ids[5]).Get<Team>()->id == (5 + 21) % 8);
+    }
+}
+
+TEST_CASE("Pool Shrinking", "[world]") {
+    struct Projectile {
+        float x = 0.0f;
+        float y = 0.0f;
+    };
+
+    microECS::World world;
+
+    SECTION("Pools do not shrink by default") {
+        std::vector<microECS::EntityID> ids = world.CreateEntities(20000, Projectile {});
+        for (size_t i = 10; i < ids.size(); i++) { world.Entity(ids[i]).Destroy(); }
+
+        microECS::PoolStats before = world.Stats().pools[0];
+        REQUIRE(before.capacity >= 20000);
+
+        world.ShrinkToFit();
+
+        microECS::WorldStats after = world.Stats();
+        REQUIRE(after.pools[0].count == 10);
+        REQUIRE(after.pools[0].capacity == 10);
+        REQUIRE(after.pools[0].indexBytes < before.indexBytes);
+        REQUIRE(after.freeEntityCount == 19990);
+        REQUIRE(world.Entity(ids[5]).Get<Projectile>() != nullptr);
+    }
+
+    SECTION("Automatic shrinking frees the dense data and the index") {
+        world.SetShrinkPolicy(microECS::ShrinkPolicy::Automatic());
+
+        std::vector<microECS::EntityID> ids = world.CreateEntities(20000, Projectile {});
+        microECS::PoolStats full = world.Stats().pools[0];
+        for (size_t i = 10; i < ids.size(); i++) { world.Entity(ids[i]).Destroy(); }
+
+        microECS::PoolStats pool = world.Stats().pools[0];
+        REQUIRE(pool.count == 10);
+        REQUIRE(pool.capacity < 4 * pool.count);
+        REQUIRE(pool.indexBytes < full.indexBytes / 4);
+        for (size_t i = 0; i < 10; i++) {
+            REQUIRE(world.Entity(ids[i]).Get<Projectile>() != nullptr);
+        }
+    }
+
+    SECTION("Alternating around a threshold does not thrash") {
+        world.SetShrinkPolicy<Projectile>(microECS::ShrinkPolicy::Automatic());
+
+        std::vector<microECS::EntityID> ids = world.CreateEntities(128, Projectile {});
+        for (size_t i = 32; i < 128; i++) { world.Entity(ids[i]).Remove<Projectile>(); }
+        size_t resizes = world.Stats().pools[0].resizeCount;
+
+        for (int i = 0; i < 1000; i++) {
+            world.Entity(ids[31]).Remove<Projectile>();
+            world.Entity(ids[31]).Add<Projectile>();
+            world.Entity(ids[32]).Add<Projectile>();
+            world.Entity(ids[32]).Remove<Projectile>();
+        }
+
+        REQUIRE(world.Stats().pools[0].resizeCount <= resizes + 1);
+    }
+}
+
+TEST_CASE("Pool Growth", "[world]") {
+    struct Particle {
+        float x = 0.0f;
+        float y = 0.0f;
+    };
+
+    microECS::World world;
+
+    SECTION("Reserve makes room up front") {
+        REQUIRE(world.Reserve<Particle>(1000));
+        world.CreateEntities(1000, Particle {});
+
+        microECS::PoolStats pool = world.Stats().pools[0];
+        REQUIRE(pool.capacity == 1000);
+        REQUIRE(pool.resizeCount == 1);
+        REQUIRE(world.Stats().resizeCount == 1);
+    }
+
+    SECTION("Geometric and fixed step growth") {
+        world.SetGrowthPolicy(microECS::GrowthPolicy::Geometric(4.0f));
+        for (int i = 0; i < 1000; i++) { world.Entity().Add<Particle>(); }
+        REQUIRE(world.Stats().pools[0].capacity == 2048);
+        REQUIRE(world.Stats().pools[0].resizeCount == 3);
+
+        struct Spark {
+            float life = 1.0f;
+        };
+
+        world.SetGrowthPolicy<Spark>(microECS::GrowthPolicy::FixedStep(100));
+        for (int i = 0; i < 250; i++) { world.Entity().Add<Spark>(); }
+        REQUIRE(world.Stats().pools[1].capacity == 332);
+        REQUIRE(world.Stats().pools[1].resizeCount == 3);
+    }
+
+    SECTION("Adaptive growth follows the adds per frame") {
+        microECS::World geometric;
+        world.SetGrowthPolicy(microECS::GrowthPolicy::Adaptive());
+
+        for (int frame = 0; frame < 10; frame++) {
+            for (int i = 0; i < 1000; i++) {
+                world.Entity().Add<Particle>();
+                geometric.Entity().Add<Particle>();
+            }
+            world.EndFrame();
+        }
+
+        REQUIRE(world.Stats().pools[0].count == 10000);
+        REQUIRE(world.Stats().pools[0].addRate == 1000.0f);
+        REQUIRE(world.Stats().resizeCount < geometric.Stats().resizeCount);
+    }
+
+    SECTION("Steady state frames never resize") {
+        world.SetGrowthPolicy(microECS::GrowthPolicy::Adaptive());
+
+        std::vector<microECS::EntityID> ids;
+        size_t resizes = 0;
+        for (int frame = 0; frame < 10; frame++) {
+            for (microECS::EntityID id : ids) { world.Entity(id).Destroy(); }
+            ids = world.CreateEntities(500, Particle {});
+            world.EndFrame();
+
+            if (frame == 0) {
+                resizes = world.Stats().resizeCount;
+            }
+        }
+
+        REQUIRE(world.Stats().resizeCount == resizes);
+    }
+}
+
+TEST_CASE("Tag Components", "[world]") {
+    struct Position {
+        float x = 0.0f;
+        float y = 0.0f;
+    };
+
+    struct Enemy {};
+
+    microECS::World world;
+    std::vector<microECS::EntityID> ids = world.CreateEntities(100, Position {});
+    for (size_t i = 0; i < ids.size(); i += 4) { world.Entity(ids[i]).Add<Enemy>(); }
+
+    SECTION("Tags are stored as membership only") {
+        REQUIRE(world.Entity(ids[0]).Has<Enemy>());
+        REQUIRE_FALSE(world.Entity(ids[1]).Has<Enemy>());
+        REQUIRE(world.Entity(ids[0]).Get<Enemy>() != nullptr);
+
+        microECS::PoolStats tags = world.Stats().pools[1];
+        REQUIRE(tags.componentSize == 0);
+        REQUIRE(tags.count == 25);
+        REQUIRE(tags.denseBytes == 0);
+
+        world.Entity(ids[0]).Remove<Enemy>();
+        REQUIRE_FALSE(world.Entity(ids[0]).Has<Enemy>());
+        REQUIRE(world.Stats().pools[1].count == 24);
+    }
+
+    SECTION("Views do not pass tags to the lambda") {
+        size_t count = 0;
+        world.View<Position, Enemy>().Each([&count](microECS::EntityID, Position& position) {
+            position.x = 1.0f;
+            count++;
+        });
+        REQUIRE(count == 25);
+        REQUIRE(world.Entity(ids[4]).Get<Position>()->x == 1.0f);
+        REQUIRE(world.Entity(ids[5]).Get<Position>()->x == 0.0f);
+
+        std::vector<microECS::EntityID> enemies;
+        world.View<Enemy>().Each([&enemies](microECS::EntityID id) { enemies.push_back(id); });
+        REQUIRE(enemies.size() == 25);
+        REQUIRE(enemies[1] == ids[4]);
+    }
+
+    SECTION("Tags survive forks, rollback and bulk creation") {
+        microECS::World fork = world.Fork();
+        fork.Entity(ids[0]).Remove<Enemy>();
+        REQUIRE(world.Entity(ids[0]).Has<Enemy>());
+
+        world.ConfigureRollback(4);
+        world.MarkRollback<Enemy>();
+        world.SaveFrame(0);
+        world.Entity(ids[1]).Add<Enemy>();
+        REQUIRE(world.RestoreFrame(0));
+        REQUIRE_FALSE(world.Entity(ids[1]).Has<Enemy>());
+
+        std::vector<microECS::EntityID> more = world.CreateEntities(10, Position {}, Enemy {});
+        REQUIRE(world.Entity(more[9]).Has<Enemy>());
+        REQUIRE(world.Stats().pools[1].count == 35);
+    }
+
+    SECTION("Tags are saved in world images") {
+        const std::string path = "microecs_tag_image_test.bin";
+        REQUIRE(world.SaveImage(path));
+
+        microECS::World loaded;
+        REQUIRE(loaded.LoadImage(path, microECS::MapMode::ReadOnly));
+        REQUIRE(loaded.Entity(ids[8]).Has<Enemy>());
+        REQUIRE_FALSE(loaded.Entity(ids[9]).Has<Enemy>());
+
+        std::remove(path.c_str());
+    }
+}
+
+namespace {
+template <size_t N>
+struct Marker {
+    size_t value = N;
+};
+
+template <typename World, size_t... Ns>
+void AddMarkers(World& world, typename World::EntityID id, std::index_sequence<Ns...>) {
+    (world.Entity(id).template Add<Marker<Ns>>(), ...);
+}
+} // namespace
+
+TEST_CASE("ID Traits", "[world]") {
+    struct Position {
+        float x = 0.0f;
+        float y = 0.0f;
+    };
+
+    SECTION("Compact IDs use 16-bit entities and smaller index pages") {
+        microECS::BasicWorld<microECS::CompactIDTraits> compact;
+        microECS::World world;
+        STATIC_REQUIRE(sizeof(decltype(compact)::EntityID) == 2);
+
+        std::vector<uint16_t> ids = compact.CreateEntities(1000, Position { 1.0f, 2.0f });
+        world.CreateEntities(1000, Position { 1.0f, 2.0f });
+        REQUIRE(ids.size() == 1000);
+        REQUIRE(compact.Entity(ids[999]).Get<Position>()->y == 2.0f);
+
+        size_t count = 0;
+        compact.View<Position>().Each([&count](uint16_t, Position& position) {
+            position.x += 1.0f;
+            count++;
+        });
+        REQUIRE(count == 1000);
+        REQUIRE(compact.Stats().pools[0].indexBytes * 4 < world.Stats().pools[0].indexBytes);
+    }
+
+    SECTION("Views of the default world deduce their components") {
+        microECS::World world;
+        world.CreateEntities(10, Position { 1.0f, 2.0f });
+
+        microECS::View view = world.View<Position>();
+        STATIC_REQUIRE(std::is_same_v<decltype(view), microECS::View<Position>>);
+        microECS::View<Position> named = world.View<Position>();
+
+        size_t count = 0;
+        view.Each([&count](microECS::EntityID, Position&) { count++; });
+        named.Each([&count](microECS::EntityID, Position&) { count++; });
+        REQUIRE(count == 20);
+    }
+
+    SECTION("Handles detect entities that were destroyed") {
+        microECS::BasicWorld<microECS::HandleIDTraits> world;
+        auto entity = world.Entity("Player").Set<Position>({ 3.0f, 4.0f });
+        uint64_t stale = entity.GetID();
+        entity.Destroy();
+
+        auto reused = world.Entity("Enemy").Add<Position>();
+        REQUIRE(microECS::HandleIDTraits::GetIndex(reused.GetID()) ==
+                microECS::HandleIDTraits::GetIndex(stale));
+        REQUIRE(reused.GetID() != stale);
+
+        REQUIRE(reused.IsValid());
+        REQUIRE_FALSE(world.Entity(stale).IsValid());
+        REQUIRE_FALSE(world.Entity(stale).Has<Position>());
+        REQUIRE(world.Entity(stale).Get<Position>() == nullptr);
+        REQUIRE(world.Entity(stale).GetName().empty());
+        REQUIRE(world.Lookup("Enemy").GetID() == reused.GetID());
+
+        world.Entity(stale).Destroy();
+        REQUIRE(reused.Has<Position>());
+
+        world.Clear();
+        REQUIRE_FALSE(reused.IsValid());
+        REQUIRE(world.Entity().GetID() != reused.GetID());
+    }
+
+    SECTION("Handles allow more than 254 component types") {
+        microECS::BasicWorld<microECS::HandleIDTraits> world;
+        auto entity = world.Entity();
+        AddMarkers(world, entity.GetID(), std::make_index_sequence<300>());
+
+        REQUIRE(world.GetComponentPoolCount() == 300);
+        REQUIRE(entity.Has<Marker<0>, Marker<299>>());
+        REQUIRE(entity.Get<Marker<299>>()->value == 299);
+    }
+
+    SECTION("Generations survive world images and deltas") {
+        microECS::BasicWorld<microECS::HandleIDTraits> world;
+        std::vector<uint64_t> ids = world.CreateEntities(4, Position {});
+        world.Entity(ids[1]).Destroy();
+        uint64_t reused = world.Entity().Set<Position>({ 5.0f, 0.0f }).GetID();
+
+        const std::string path = "microecs_handle_image_test.bin";
+        REQUIRE(world.SaveImage(path));
+
+        microECS::BasicWorld<microECS::HandleIDTraits> loaded;
+        REQUIRE(loaded.LoadImage(path));
+        REQUIRE(loaded.Entity(reused).Get<Position>()->x == 5.0f);
+        REQUIRE_FALSE(loaded.Entity(ids[1]).IsValid());
+
+        microECS::World narrow;
+        REQUIRE_FALSE(narrow.LoadImage(path));
+        std::remove(path.c_str());
+
+        microECS::BasicWorld<microECS::HandleIDTraits> client;
+        client.ApplyDelta(world.Diff(decltype(world)::WorldSnapshot()));
+        REQUIRE(client.Entity(reused).Get<Position>()->x == 5.0f);
+        REQUIRE_FALSE(client.Entity(ids[1]).IsValid());
+    }
+
+    SECTION("Fixed-capacity worlds size their index from the traits") {
+        using Capacity = microECS::BasicWorldCapacity<microECS::CompactIDTraits>;
+        microECS::BasicWorld<microECS::CompactIDTraits> world(Capacity::For<Position>(500, 500));
+        REQUIRE(world.CreateEntities(500, Position {}).size() == 500);
+        REQUIRE(world.CreateEntities(1, Position {}).empty());
+    }
+}
+
+TEST_CASE("Entity Recycling", "[world]") {
+    struct Position {
+        float x = 0.0f;
+        float y = 0.0f;
+    };
+
+    microECS::World world;
+    std::vector<microECS::EntityID> ids = world.CreateEntities(4, Position {});
+
+    SECTION("Destroyed entities are not valid") {
+        world.Entity(ids[2]).Destroy();
+        REQUIRE_FALSE(world.Entity(ids[2]).IsValid());
+        REQUIRE(world.Entity(ids[3]).IsValid());
+
+        world.Entity(ids[2]).Destroy();
+        REQUIRE(world.Stats().freeEntityCount == 1);
+    }
+
+    SECTION("IDs are reused oldest first by default") {
+        world.Entity(ids[1]).Destroy();
+        world.Entity(ids[3]).Destroy();
+        REQUIRE(world.Entity().GetID() == ids[1]);
+        REQUIRE(world.Entity().GetID() == ids[3]);
+    }
+
+    SECTION("IDs are reused newest first with the LIFO policy") {
+        world.SetReusePolicy(microECS::ReusePolicy::Lifo);
+        world.Entity(ids[1]).Destroy();
+        world.Entity(ids[3]).Destroy();
+        REQUIRE(world.Entity().GetID() == ids[3]);
+        REQUIRE(world.Entity().GetID() == ids[1]);
+    }
+
+    SECTION("Destroying and creating entities does not allocate") {
+        microECS::CountingResource memory;
+        microECS::World churn(&memory);
+        microECS::Prefab prefab = churn.Prefab();
+        prefab.Add<Position>();
+
+        std::vector<microECS::EntityID> entities(1000);
+        churn.Instantiate(prefab, entities.size(), entities.data());
+        churn.DestroyAll<Position>();
+
+        memory.ResetCounters();
+        for (int frame = 0; frame < 10; frame++) {
+            churn.Instantiate(prefab, entities.size(), entities.data());
+            churn.DestroyAll<Position>();
+        }
+        REQUIRE(memory.GetAllocationCount() == 0);
+    }
+
+    SECTION("The free list survives world images") {
+        world.Entity(ids[2]).Destroy();
+        world.Entity(ids[0]).Destroy();
+
+        const std::string path = "microecs_free_list_test.bin";
+        REQUIRE(world.SaveImage(path));
+        microECS::World loaded;
+        REQUIRE(loaded.LoadImage(path));
+        std::remove(path.c_str());
+
+        REQUIRE_FALSE(loaded.Entity(ids[0]).IsValid());
+        REQUIRE(loaded.Entity().GetID() == ids[2]);
+        REQUIRE(loaded.Entity().GetID() == ids[0]);
+        REQUIRE(loaded.Entity().GetID() == 4);
+    }
+
+    SECTION("Entities added by a delta leave the free list") {
+        microECS::World client;
+        client.ApplyDelta(world.Diff(microECS::World::WorldSnapshot()));
+        client.Entity(ids[1]).Destroy();
+        client.ApplyDelta(world.Diff(microECS::World::WorldSnapshot()));
+
+        REQUIRE(client.Entity(ids[1]).IsValid());
+        REQUIRE(client.Entity().GetID() == 4);
+    }
+}
+
+TEST_CASE("Concurrent Reservation", "[world]") {
+    struct Position {
+        float x = 0.0f;
+        float y = 0.0f;
+    };
+
+    struct Loaded {};
+
+    SECTION("Threads reserve distinct IDs while the main thread creates entities") {
+        microECS::World world;
+        std::vector<microECS::EntityID> old = world.CreateEntities(8, Position {});
+        world.Entity(old[3]).Destroy();
+
+        constexpr size_t THREADS = 4;
+        constexpr size_t PER_THREAD = 1000;
+        std::vector<microECS::EntityID> reserved(THREADS * PER_THREAD);
+        std::vector<microECS::World::CommandBuffer> commands(THREADS);
+        std::vector<char> reservedAll(THREADS, 1); // Catch2 assertions are not thread-safe
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < THREADS; t++) {
+            threads.emplace_back([&, t]() {
+                microECS::EntityID* ids = reserved.data() + t * PER_THREAD;
+                for (size_t i = 0; i < PER_THREAD; i += 100) {
+                    reservedAll[t] &= world.ReserveEntities(100, ids + i);
+                }
+                for (size_t i = 0; i < PER_THREAD; i++) {
+                    commands[t].Set(ids[i], Position { static_cast<float>(t), 0.0f });
+                    commands[t].Add<Loaded>(ids[i]);
+                }
+            });
+        }
+
+        std::vector<microECS::EntityID> created;
+        for (int i = 0; i < 500; i++) { created.push_back(world.Entity().GetID()); }
+        for (std::thread& thread : threads) { thread.join(); }
+        REQUIRE(std::count(reservedAll.begin(), reservedAll.end(), 1) == THREADS);
+
+        REQUIRE(created[0] == old[3]);
+        std::vector<microECS::EntityID> all = reserved;
+        all.insert(all.end(), created.begin(), created.end());
+        std::sort(all.begin(), all.end());
+        REQUIRE(std::adjacent_find(all.begin(), all.end()) == all.end());
+
+        for (auto& buffer : commands) { world.Apply(buffer); }
+        REQUIRE(commands[0].IsEmpty());
+        REQUIRE(world.Stats().pools[1].count == THREADS * PER_THREAD);
+        REQUIRE(world.Entity(reserved[PER_THREAD * 2 + 5]).Get<Position>()->x == 2.0f);
+        REQUIRE(world.Stats().entityCount == 8 - 1 + 500 + THREADS * PER_THREAD);
+    }
+
+    SECTION("Reserved entities exist once they are flushed") {
+        microECS::World world;
+        microECS::EntityID id = world.ReserveEntity();
+        REQUIRE_FALSE(world.Entity(id).IsValid());
+
+        world.FlushReservedEntities();
+        REQUIRE(world.Entity(id).IsValid());
+        REQUIRE(world.Entity().GetID() == id + 1);
+    }
+
+    SECTION("Commands run in order and skip destroyed entities") {
+        microECS::World world;
+        microECS::EntityID kept = world.ReserveEntity();
+        microECS::EntityID dropped = world.ReserveEntity();
+
+        microECS::World::CommandBuffer commands;
+        commands.Add<Position>(kept).Set(kept, Position { 3.0f, 4.0f }).Add<Loaded>(kept);
+        commands.Remove<Loaded>(kept);
+        commands.Destroy(dropped).Add<Position>(dropped);
+        REQUIRE(commands.GetCommandCount() == 6);
+
+        world.Apply(commands);
+        REQUIRE(world.Entity(kept).Get<Position>()->y == 4.0f);
+        REQUIRE_FALSE(world.Entity(kept).Has<Loaded>());
+        REQUIRE_FALSE(world.Entity(dropped).IsValid());
+        REQUIRE(world.Stats().pools[0].count == 1);
+    }
+
+    SECTION("Reservations respect fixed capacity") {
+        microECS::World world(microECS::WorldCapacity::For<Position>(10, 10));
+        microECS::EntityID ids[10];
+        REQUIRE(world.ReserveEntities(8, ids));
+        REQUIRE_FALSE(world.ReserveEntities(3, ids));
+        REQUIRE(world.ReserveEntity() == 8);
+        REQUIRE(world.CreateEntities(2, Position {}).empty());
+        REQUIRE(world.CreateEntities(1, Position {}).size() == 1);
+        REQUIRE(world.ReserveEntity() == microECS::INVALID_ENTITY_ID);
+    }
+
+    SECTION("Clearing keeps pending reservations") {
+        microECS::World world;
+        world.CreateEntities(4, Position {});
+        microECS::EntityID reserved = world.ReserveEntity();
+        world.Clear();
+
+        std::vector<microECS::EntityID> created = world.CreateEntities(8, Position {});
+        REQUIRE(std::find(created.begin(), created.end(), reserved) == created.end());
+
+        world.FlushReservedEntities();
+        REQUIRE(world.Entity(reserved).IsValid());
+        REQUIRE_FALSE(world.Entity(reserved).Has<Position>());
+    }
+
+    SECTION("Handles reserved after a clear do not collide with old handles") {
+        microECS::BasicWorld<microECS::HandleIDTraits> world;
+        uint64_t old = world.Entity().GetID();
+        world.Clear();
+
+        uint64_t reserved = world.ReserveEntity();
+        world.FlushReservedEntities();
+        REQUIRE(reserved != old);
+        REQUIRE(world.Entity(reserved).IsValid());
+        REQUIRE_FALSE(world.Entity(old).IsValid());
+        REQUIRE(world.Entity().GetID() != old);
+    }
+}
+
+namespace {
+// Mixed alignments, with padding between the fields
+struct Body {
+    float x = 0.0f;
+    double mass = 1.0;
+    uint8_t flags = 0;
+    int32_t id = 0;
+};
+} // namespace
+
+MECS_SOA(Body, x, mass, flags, id);
+
+TEST_CASE("SoA Components", "[world]") {
+    struct Position {
+        float x = 0.0f;
+        float y = 0.0f;
+    };
+
+    auto load = [](microECS::World& world, microECS::EntityID entityID) {
+        Body body;
+        body.id = -1;
+        world.View<Body>().Each([&](microECS::EntityID id, microECS::SoARef<Body> ref) {
+            if (id == entityID) {
+                body = ref.Load();
+            }
+        });
+        return body;
+    };
+
+    microECS::World world;
+    std::vector<microECS::EntityID> ids = world.CreateEntities(100, Body {});
+    for (size_t i = 0; i < ids.size(); i++) {
+        world.Entity(ids[i]).Set(Body { static_cast<float>(i), 2.0 * i, 1, static_cast<int>(i) });
+    }
+
+    SECTION("Fields are stored in aligned columns") {
+        auto x = world.Field<&Body::x>();
+        auto mass = world.Field<&Body::mass>();
+        auto id = world.Field<&Body::id>();
+        REQUIRE(x.Size() == 100);
+        REQUIRE(reinterpret_cast<uintptr_t>(mass.Data()) % 64 == 0);
+        REQUIRE(reinterpret_cast<uintptr_t>(id.Data()) % alignof(int32_t) == 0);
+        REQUIRE(x[7] == 7.0f);
+        REQUIRE(mass[7] == 14.0);
+
+        for (size_t i = 0; i < x.Size(); i++) { x[i] += static_cast<float>(mass[i]); }
+        REQUIRE(load(world, ids[7]).x == 21.0f);
+        REQUIRE(load(world, ids[7]).flags == 1);
+    }
+
+    SECTION("Views hand out references to the fields") {
+        world.View<Body>().Each([](microECS::EntityID, microECS::SoARef<Body> body) {
+            body.Get<&Body::x>() = static_cast<float>(body.Get<&Body::id>()) * 10.0f;
+        });
+        REQUIRE(load(world, ids[3]).x == 30.0f);
+
+        for (size_t i = 0; i < ids.size(); i += 2) { world.Entity(ids[i]).Add<Position>(); }
+
+        size_t count = 0;
+        world.View<Position, Body>().Each(
+            [&count](microECS::EntityID, Position& position, microECS::SoARef<Body> body) {
+                position.x = body.Get<&Body::x>();
+                body.Store(Body { 0.5f, 4.0, 2, body.Get<&Body::id>() });
+                count++;
+            });
+        REQUIRE(count == 50);
+        REQUIRE(world.Entity(ids[4]).Get<Position>()->x == 40.0f);
+        REQUIRE(load(world, ids[4]).mass == 4.0);
+        REQUIRE(load(world, ids[5]).mass == 10.0);
+    }
+
+    SECTION("Removing components keeps the columns in step") {
+        for (size_t i = 0; i < ids.size(); i += 3) { world.Entity(ids[i]).Remove<Body>(); }
+        world.Entity().Set(Body { 1.0f, 2.0, 1, 1000 });
+
+        size_t count = 0;
+        bool matching = true;
+        world.View<Body>().Each([&](microECS::EntityID id, microECS::SoARef<Body> body) {
+            Body value = body.Load();
+            matching = matching && (value.id == 1000 || ids[value.id] == id) &&
+                       value.mass == 2.0 * value.x;
+            count++;
+        });
+        REQUIRE(matching);
+        REQUIRE(count == 67);
+    }
+
+    SECTION("Forks and rollback copy the columns") {
+        microECS::World fork = world.Fork();
+        fork.Field<&Body::x>()[0] = 99.0f;
+        REQUIRE(world.Field<&Body::x>()[0] == 0.0f);
+        REQUIRE(load(fork, ids[0]).x == 99.0f);
+
+        world.ConfigureRollback(4);
+        world.MarkRollback<Body>(128);
+        world.SaveFrame(0);
+        world.Field<&Body::mass>()[5] = -1.0;
+        world.Entity(ids[6]).Remove<Body>();
+        REQUIRE(world.RestoreFrame(0));
+        REQUIRE(load(world, ids[5]).mass == 10.0);
+        REQUIRE(load(world, ids[6]).id == 6);
+    }
+
+    SECTION("Deltas and images carry packed components") {
+        microECS::World client;
+        client.ApplyDelta(world.Diff(microECS::WorldSnapshot()));
+        REQUIRE(load(client, ids[9]).mass == 18.0);
+
+        microECS::WorldSnapshot previous = world.Snapshot();
+        world.View<Body>().Each([](microECS::EntityID id, microECS::SoARef<Body> body) {
+            if (id == 9) {
+                body.Get<&Body::id>() = 900;
+            }
+        });
+
+        microECS::WorldDelta delta = world.Diff(previous);
+        REQUIRE(delta.pools[0].modified.size() == 1);
+        client.ApplyDelta(delta);
+        REQUIRE(load(client, ids[9]).id == 900);
+        REQUIRE(load(client, ids[9]).x == 9.0f);
+
+        const std::string path = "microecs_soa_image_test.bin";
+        REQUIRE(world.SaveImage(path));
+
+        microECS::World loaded;
+        REQUIRE(loaded.LoadImage(path, microECS::MapMode::ReadOnly));
+        REQUIRE(load(loaded, ids[9]).id == 900);
+        REQUIRE(loaded.Field<&Body::mass>().Size() == 100);
+        REQUIRE(load(loaded, ids[50]).mass == 100.0);
+
+        std::remove(path.c_str());
+    }
+}
+
+namespace {
+struct Motion {
+    float x = 0.0f;
+    float vx = 1.0f;
+};
+
+struct MotionHistory {
+    float spawnX = -1.0f;
+    uint32_t bounces = 0;
+    char label[24] = {};
+};
+} // namespace
+
+MECS_SPLIT(Motion, MotionHistory);
+
+TEST_CASE("Split Components", "[world]") {
+    // Both parts list the same entities in the same order
+    auto inStep = [](microECS::World& world) {
+        std::vector<microECS::EntityID> hot;
+        std::vector<microECS::EntityID> cold;
+        world.View<Motion>().Each([&hot](microECS::EntityID id, Motion&) { hot.push_back(id); });
+        world.View<MotionHistory>().Each(
+            [&cold](microECS::EntityID id, MotionHistory&) { cold.push_back(id); });
+        return hot == cold;
+    };
+
+    microECS::World world;
+    std::vector<microECS::EntityID> ids =
+        world.CreateEntities(100, Motion {}, MotionHistory { 0.0f, 7, {} });
+    for (size_t i = 0; i < ids.size(); i++) {
+        world.Entity(ids[i]).Set(Motion { static_cast<float>(i), 2.0f });
+    }
+    REQUIRE(inStep(world));
+    REQUIRE(world.Entity(ids[10]).Get<MotionHistory>()->bounces == 7);
+
+    SECTION("Adding or removing either part changes both") {
+        microECS::Entity added = world.Entity().Add<MotionHistory>();
+        REQUIRE(added.Has<Motion>());
+        REQUIRE(added.Get<Motion>()->vx == 1.0f);
+
+        world.Entity().Set(Motion { 5.0f, 5.0f });
+        world.Entity(ids[3]).Remove<Motion>();
+        world.Entity(ids[4]).Remove<MotionHistory>();
+        REQUIRE_FALSE(world.Entity(ids[3]).Has<MotionHistory>());
+        REQUIRE_FALSE(world.Entity(ids[4]).Has<Motion>());
+        REQUIRE(inStep(world));
+
+        size_t count = 0;
+        world.View<Motion, MotionHistory>().Each(
+            [&count](microECS::EntityID, Motion& motion, MotionHistory& history) {
+                history.bounces += static_cast<uint32_t>(motion.vx);
+                count++;
+            });
+        REQUIRE(count == 100);
+        REQUIRE(world.Entity(ids[99]).Get<MotionHistory>()->bounces == 9);
+        REQUIRE(world.Entity(ids[99]).Get<Motion>()->x == 99.0f);
+    }
+
+    SECTION("Destroying entities removes both parts") {
+        struct Doomed {};
+        auto count = [&world]() {
+            size_t cold = 0;
+            world.View<MotionHistory>().Each(
+                [&cold](microECS::EntityID, MotionHistory&) { cold++; });
+            return cold;
+        };
+
+        world.Entity(ids[0]).Destroy();
+        REQUIRE(inStep(world));
+
+        // Few, many and all entities of the pools take different paths
+        for (size_t i = 1; i < 6; i++) { world.Entity(ids[i]).Add<Doomed>(); }
+        world.DestroyAll<Doomed>();
+        REQUIRE(inStep(world));
+        for (size_t i = 6; i < 66; i++) { world.Entity(ids[i]).Add<Doomed>(); }
+        world.DestroyAll<Doomed>();
+        REQUIRE(inStep(world));
+        REQUIRE(count() == 34);
+        REQUIRE(world.Entity(ids[80]).Get<MotionHistory>()->bounces == 7);
+
+        world.DestroyAll<Motion>();
+        REQUIRE(count() == 0);
+    }
+
+    SECTION("Forks and rollback keep the parts together") {
+        microECS::World fork = world.Fork();
+        fork.Entity(ids[0]).Remove<MotionHistory>();
+        fork.Entity().Add<Motion>();
+        fork.Entity(ids[1]).Get<MotionHistory>()->bounces = 100;
+        REQUIRE(inStep(fork));
+        REQUIRE(inStep(world));
+        REQUIRE(world.Entity(ids[0]).Has<Motion>());
+        REQUIRE(world.Entity(ids[1]).Get<MotionHistory>()->bounces == 7);
+
+        world.Clear<Motion>();
+        REQUIRE_FALSE(world.Entity(ids[1]).Has<MotionHistory>());
+        REQUIRE(fork.Entity(ids[1]).Has<MotionHistory>());
+        REQUIRE(inStep(fork));
+
+        fork.ConfigureRollback(4);
+        fork.MarkRollback<Motion>(128);
+        fork.SaveFrame(0);
+        fork.Entity(ids[2]).Remove<Motion>();
+        fork.Entity(ids[5]).Get<MotionHistory>()->bounces = 0;
+        REQUIRE(fork.RestoreFrame(0));
+        REQUIRE(inStep(fork));
+        REQUIRE(fork.Entity(ids[2]).Get<MotionHistory>()->bounces == 7);
+        REQUIRE(fork.Entity(ids[5]).Get<MotionHistory>()->bounces == 7);
+    }
+
+    SECTION("Deltas and images link the parts again") {
+        microECS::World client;
+        client.View<Motion>().Each([](microECS::EntityID, Motion&) {});
+        client.ApplyDelta(world.Diff(microECS::WorldSnapshot()));
+        REQUIRE(inStep(client));
+        REQUIRE(client.Entity(ids[9]).Get<Motion>()->x == 9.0f);
+
+        microECS::WorldSnapshot previous = world.Snapshot();
+        world.Entity(ids[9]).Remove<Motion>();
+        world.Entity(ids[10]).Get<MotionHistory>()->bounces = 70;
+        client.ApplyDelta(world.Diff(previous));
+        REQUIRE(inStep(client));
+        REQUIRE_FALSE(client.Entity(ids[9]).Has<MotionHistory>());
+        REQUIRE(client.Entity(ids[10]).Get<MotionHistory>()->bounces == 70);
+
+        const std::string path = "microecs_split_image_test.bin";
+        REQUIRE(world.SaveImage(path));
+
+        microECS::World loaded;
+        REQUIRE(loaded.LoadImage(path, microECS::MapMode::CopyOnWrite));
+        REQUIRE(inStep(loaded));
+        REQUIRE(loaded.Entity(ids[10]).Get<MotionHistory>()->bounces == 70);
+        loaded.Entity(ids[11]).Remove<Motion>();
+        REQUIRE_FALSE(loaded.Entity(ids[11]).Has<MotionHistory>());
+        REQUIRE(inStep(loaded));
+
+        std::remove(path.c_str());
+    }
+}
+
+namespace {
+struct Material {
+    float albedo[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    uint32_t shader = 0;
+};
+} // namespace
+
+MECS_SHARED(Material);
+
+TEST_CASE("Shared Components", "[world]") {
+    auto valueCount = [](const microECS::World& world) {
+        size_t values = 0;
+        for (const microECS::PoolStats& pool : world.Stats().pools) {
+            values += pool.sharedValueCount;
+        }
+        return values;
+    };
+
+    // Entities per shader, as the groups of a view see them
+    auto groups = [](microECS::World& world) {
+        std::vector<size_t> sizes(10, 0);
+        world.View<Material>().EachGroup(
+            [&sizes](const Material& material, const microECS::EntityID*, size_t count) {
+                sizes[material.shader] += count;
+            });
+        return sizes;
+    };
+
+    microECS::World world;
+    std::vector<microECS::EntityID> ids = world.CreateEntities(1000, Material {});
+    for (size_t i = 0; i < ids.size(); i++) {
+        world.Entity(ids[i]).Set(Material { { 1.0f, 0.5f, 0.5f, 1.0f }, uint32_t(i % 4) });
+    }
+    const std::vector<size_t> initial = { 250, 250, 250, 250, 0, 0, 0, 0, 0, 0 };
+    REQUIRE(valueCount(world) == 4);
+    REQUIRE(groups(world) == initial);
+    REQUIRE(world.Entity(ids[6]).Get<Material>()->shader == 2);
+    static_assert(std::is_same_v<decltype(world.Entity(ids[6]).Get<Material>()), const Material*>);
+
+    SECTION("Views hand out values and group entities by value") {
+        struct Visible {};
+        for (size_t i = 0; i < ids.size(); i += 4) {
+            world.Entity(ids[i]).Add<Visible>();
+            world.Entity(ids[i + 1]).Add<Visible>();
+        }
+
+        size_t calls = 0;
+        bool grouped = true;
+        world.View<Material, Visible>().EachGroup(
+            [&](const Material& material, const microECS::EntityID* entities, size_t count) {
+                calls++;
+                grouped = grouped && count == 250 && material.shader < 2;
+                for (size_t i = 0; i < count; i++) {
+                    microECS::Entity entity = world.Entity(entities[i]);
+                    grouped = grouped && entity.Has<Visible>() &&
+                              entity.Get<Material>()->shader == material.shader;
+                }
+            });
+        REQUIRE(calls == 2);
+        REQUIRE(grouped);
+
+        uint32_t shaders = 0;
+        world.View<Material>().Each(
+            [&shaders](microECS::EntityID, const Material& material) {
+                shaders += material.shader;
+            });
+        REQUIRE(shaders == 1500);
+        world.View<Material, Visible>().Each(
+            [&shaders](microECS::EntityID, const Material& material) {
+                shaders -= material.shader;
+            });
+        REQUIRE(shaders == 1250);
+    }
+
+    SECTION("Values are dropped with their last reference") {
+        for (size_t i = 2; i < ids.size(); i += 4) {
+            world.Entity(ids[i]).Set(Material { { 1.0f, 0.5f, 0.5f, 1.0f }, 7 });
+        }
+        REQUIRE(valueCount(world) == 4);
+        for (size_t i = 3; i < ids.size(); i += 4) { world.Entity(ids[i]).Remove<Material>(); }
+        REQUIRE(valueCount(world) == 3);
+
+        struct Doomed {};
+        for (size_t i = 0; i < ids.size(); i += 4) { world.Entity(ids[i]).Add<Doomed>(); }
+        world.DestroyAll<Doomed>();
+        REQUIRE(valueCount(world) == 2);
+        REQUIRE(groups(world) == std::vector<size_t> { 0, 250, 0, 0, 0, 0, 0, 250, 0, 0 });
+
+        // A freed value is stored again when it comes back
+        world.Entity().Set(Material { { 1.0f, 0.5f, 0.5f, 1.0f }, 3 });
+        REQUIRE(valueCount(world) == 3);
+
+        world.Clear<Material>();
+        REQUIRE(valueCount(world) == 0);
+        REQUIRE(groups(world) == std::vector<size_t>(10, 0));
+    }
+
+    SECTION("Forks and rollback keep their own values") {
+        microECS::World fork = world.Fork();
+        fork.Entity(ids[0]).Set(Material { { 0.0f, 0.0f, 0.0f, 1.0f }, 9 });
+        REQUIRE(valueCount(fork) == 5);
+        REQUIRE(valueCount(world) == 4);
+        REQUIRE(world.Entity(ids[0]).Get<Material>()->shader == 0);
+
+        world.ConfigureRollback(4);
+        world.MarkRollback<Material>(1024);
+        world.SaveFrame(0);
+        world.Entity(ids[1]).Set(Material { { 0.0f, 0.0f, 0.0f, 1.0f }, 8 });
+        world.Entity(ids[2]).Remove<Material>();
+        REQUIRE(world.RestoreFrame(0));
+        REQUIRE(valueCount(world) == 4);
+        REQUIRE(groups(world) == initial);
+    }
+
+    SECTION("Deltas and images store the values again") {
+        // The pool of the client is created by the delta, before the type is known
+        microECS::World client;
+        client.ApplyDelta(world.Diff(microECS::WorldSnapshot()));
+        REQUIRE(groups(client) == initial);
+        REQUIRE(valueCount(client) == 4);
+
+        microECS::WorldSnapshot previous = world.Snapshot();
+        world.Entity(ids[5]).Set(Material { { 1.0f, 0.5f, 0.5f, 1.0f }, 5 });
+        world.Entity(ids[9]).Remove<Material>();
+        client.ApplyDelta(world.Diff(previous));
+        REQUIRE(client.Entity(ids[5]).Get<Material>()->shader == 5);
+        REQUIRE_FALSE(client.Entity(ids[9]).Has<Material>());
+        REQUIRE(groups(client) == groups(world));
+        REQUIRE(valueCount(client) == 5);
+
+        const std::string path = "microecs_shared_image_test.bin";
+        REQUIRE(world.SaveImage(path));
+
+        microECS::World loaded;
+        REQUIRE(loaded.LoadImage(path, microECS::MapMode::CopyOnWrite));
+        REQUIRE(groups(loaded) == groups(world));
+        REQUIRE(valueCount(loaded) == 5);
+
+        std::remove(path.c_str());
+    }
+}